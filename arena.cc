@@ -0,0 +1,49 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//////////////////////////////////////////////////////////////////////
+//
+//  arena.cc
+//
+//  Chunks are carved front to back; a request that does not fit in
+//  the rest of the current chunk starts a new one.  Requests larger
+//  than a chunk get a chunk of their own.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include "arena.h"
+#include "utilities.h"
+
+#define ARENA_CHUNK_SIZE (64 * 1024)
+#define ARENA_ALIGN      16
+
+Arena compile_arena;
+
+void *Arena::allocate(size_t size)
+{
+  size = (size + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+  if (size > (size_t) (limit - next)) {
+    size_t chunk_size = size > ARENA_CHUNK_SIZE ? size : ARENA_CHUNK_SIZE;
+    char *chunk = (char *) malloc(chunk_size);
+    if (chunk == NULL)
+      fatal_error("out of memory");
+    chunks.push_back(chunk);
+    next = chunk;
+    limit = chunk + chunk_size;
+  }
+  void *p = next;
+  next += size;
+  return p;
+}
+
+void Arena::release()
+{
+  for (unsigned int i = 0; i < chunks.size(); i++)
+    free(chunks[i]);
+  chunks.clear();
+  next = limit = NULL;
+}
@@ -0,0 +1,42 @@
+// -*-Mode: C++;-*-
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//////////////////////////////////////////////////////////////////////
+//
+//  arena.h
+//
+//  A bump-pointer allocator for objects that live as long as the
+//  compilation: AST nodes, symbol table entries and list cells, and
+//  string table entries.  Nothing is freed one object at a time; the
+//  whole arena is released at the end of main.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+#include <stddef.h>
+#include <vector>
+
+class Arena {
+private:
+  char *next;                  // first free byte of the current chunk
+  char *limit;                 // end of the current chunk
+  std::vector<char *> chunks;  // every chunk handed out by malloc
+public:
+  Arena(): next(NULL), limit(NULL) { }
+
+  // size bytes aligned for any type
+  void *allocate(size_t size);
+
+  // free every chunk at once; all pointers into the arena die
+  void release();
+};
+
+extern Arena compile_arena;
+
+#endif
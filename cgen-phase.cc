@@ -6,6 +6,7 @@
 #include "seal-stmt.h"
 #include "seal-expr.h"
 #include "cgen_gc.h"
+#include "arena.h"
 
 extern int optind;            // for option processing
 extern char *out_filename;    // name of output assembly
@@ -20,15 +21,52 @@ char *curr_filename = "<stdin>";
 
 void handle_flags(int argc, char *argv[]);
 
+//
+// The assembly goes through one large buffer that is written out when
+// it fills up and once at the end.  endl still ends every line, but the
+// flush it asks for is ignored, so there is no write(2) per instruction.
+//
+#define ASM_BUFFER_SIZE (1 << 20)
+
+class AsmBuffer : public std::streambuf {
+private:
+  FILE *out;
+  char *buf;
+public:
+  AsmBuffer(FILE *f) : out(f), buf(new char[ASM_BUFFER_SIZE]) {
+    setp(buf, buf + ASM_BUFFER_SIZE);
+  }
+  ~AsmBuffer() { delete [] buf; }
+
+  // write what is buffered to the file; false on an I/O error
+  bool write_out() {
+    size_t n = pptr() - pbase();
+    bool ok = fwrite(pbase(), 1, n, out) == n;
+    setp(buf, buf + ASM_BUFFER_SIZE);
+    return ok;
+  }
+protected:
+  int overflow(int c) {
+    if (!write_out()) return EOF;
+    if (c != EOF) {
+      *pptr() = c;
+      pbump(1);
+    }
+    return c == EOF ? 0 : c;
+  }
+  // the flush of endl
+  int sync() { return 0; }
+};
+
 int main(int argc, char *argv[]) {
   int firstfile_index;
+  handle_flags(argc,argv);
   fin = fopen(argv[optind], "r");
 	    if (fin == NULL) {
 		cerr << "Could not open input file " << argv[optind] << endl;
 		exit(1);
 	}
   curr_lineno = 1;
-  handle_flags(argc,argv);
   firstfile_index = optind;
 
   if (!out_filename && optind < argc) {   // no -o option
@@ -53,15 +91,25 @@ int main(int argc, char *argv[]) {
     exit(-1);
   }
   if (out_filename) {
-      ofstream s(out_filename);
-      if (!s) {
+      FILE *out = fopen(out_filename, "w");
+      if (!out) {
         cerr << "Cannot open output file " << out_filename << endl;
         exit(1);
       }
+      // AsmBuffer does the buffering
+      setvbuf(out, NULL, _IONBF, 0);
+      AsmBuffer buffer(out);
+      ostream s(&buffer);
       ast_root->cgen(s);
+      if (!buffer.write_out() || fclose(out) != 0) {
+        cerr << "Cannot write output file " << out_filename << endl;
+        exit(1);
+      }
   } else {
       ast_root->cgen(cout);
   }
   fclose(fin);
+  // the AST, symbol tables and string tables go in one shot
+  compile_arena.release();
 }
 
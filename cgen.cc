@@ -8,40 +8,67 @@
 
 #include "cgen.h"
 #include "cgen_gc.h"
+#include "cgen_ir.h"
+#include "cgen_asm.h"
+#include "cgen_peephole.h"
 #include <vector>
 #include <stack>
+#include <algorithm>
 #include <cmath>
+#include <climits>
 
 using namespace std;
 
 extern void emit_string_constant(ostream &str, char *s);
 
 extern int cgen_debug;
+extern int cgen_dump_ir;
+extern int cgen_optimize;
+extern int cgen_inline_threshold;
+extern int cgen_vector_lanes;
+extern int cgen_unroll_factor;
+extern bool disable_reg_alloc;
 
 static char *CALL_REGS[] = {RDI, RSI, RDX, RCX, R8, R9};
-static char *CALL_XMM[] = {XMM0, XMM1, XMM2, XMM3};
+static char *CALL_XMM[] = {XMM0, XMM1, XMM2, XMM3, XMM4, XMM5, XMM6, XMM7};
+#define CALL_REG_COUNT 6   // Int arguments in CALL_REGS, the rest go on the stack
+#define CALL_XMM_COUNT 8   // Float arguments in CALL_XMM, likewise
+
+// registers the allocator hands out to virtual registers.
+// RBX, R12-R15 are saved by the prologue and R10, R11 around a call,
+// so Int values survive calls in any of them; XMM0-XMM7 carry float
+// arguments and scratch values, so Float values use XMM8-XMM15, which
+// are saved around a call too.
+static char *ALLOC_REGS[] = {RBX, R12, R13, R14, R15, R10, R11};
+#define CALLEE_SAVED_REGS 5   // ALLOC_REGS[0..4] are preserved across calls by the ABI
+// a function that makes no call takes the registers it need not save first
+static char *LEAF_ALLOC_REGS[] = {R10, R11, RBX, R12, R13, R14, R15};
+static char *ALLOC_XMM[] = {XMM8, XMM9, XMM10, XMM11, XMM12, XMM13, XMM14, XMM15};
+static const IrRegPool INT_POOL = {7, true, CALLEE_SAVED_REGS};
+static const IrRegPool FLOAT_POOL = {8, true, 0};
+
+// the block being written uses ymm registers: its float instructions
+// take their VEX forms, as mixing in SSE ones stalls on the upper halves
+static bool curr_vex = false;
 
 typedef SymbolTable<Symbol, int> ObjectEnvironment;
-static ObjectEnvironment varNameToAddr; // with the help of name_proc, Symbol -> char[] related with addr
-static vector<char *> name_proc;  // assist the varNameToAddr
-static int curr_usage = 0;  // indicate the height between rsp and rbp
+static ObjectEnvironment varNameToAddr; // with the help of name_proc, Symbol -> IR operand of the variable
+static vector<IrOperand> name_proc;  // assist the varNameToAddr
 static int pos_available = 0;  // indicate which .POSX: is available
-static stack<char const *> operandStack;  // TODO: some of its content cannot be cleared e.g. a+b;
+static stack<IrOperand> operandStack;
 static bool init_once = true;
 struct LOOP {
-    char const *back;
-    char const *next;
+    int back;
+    int next;
 
-    LOOP(char *b, char *n){
+    LOOP(int b, int n){
         back = b; next = n;
     }
-
-    ~LOOP() {
-        delete [] back;
-        delete [] next;
-    }
-};  // restore the begining and next POS
-static stack<LOOP *> LOOP_MSG;
+};  // restore the blocks to continue and to break to
+static stack<LOOP> LOOP_MSG;
+static IrFunction *curr_fn;  // function being lowered
+static vector<IrFunction> ir_program;  // every function, lowered before any is emitted
+static int curr_block;       // block receiving the lowered instructions
 
 void cgen_helper(Decls decls, ostream &s);
 
@@ -116,211 +143,367 @@ void Program_class::cgen(ostream &os) {
 //
 //  emit_* procedures
 //
-//  emit_X  writes code for operation "X" to the output stream.
-//  There is an emit_X for each opcode X, as well as emit_ functions
-//  for generating names according to the naming conventions (see emit.h)
-//  and calls to support functions defined in the trap handler.
+//  emit_X  records code for operation "X" in the code of the function
+//  being selected.  There is an emit_X for each opcode X, as well as
+//  emit_ functions for generating names according to the naming
+//  conventions (see emit.h) and calls to support functions defined in
+//  the trap handler.
 //
-//  Register names and addresses are passed as strings.  See `emit.h'
-//  for symbolic names you can use to refer to the strings.
+//  Operands are passed as AsmOperand values, see `cgen_asm.h'; the
+//  ones that can only be registers are passed as the names in `emit.h'.
 //
 //////////////////////////////////////////////////////////////////////////////
 
-static void emit_mov(const char *source, const char *dest, ostream &s) {
-    s << MOV << source << COMMA << dest << endl;
+static void emit_instr(const char *op, AsmCode &s) {
+    AsmInstr instr;
+    instr.op = op;
+    s.push_back(instr);
+}
+
+static void emit_instr(const char *op, const AsmOperand &a, AsmCode &s) {
+    emit_instr(op, s);
+    s.back().args.push_back(a);
+}
+
+static void emit_instr(const char *op, const AsmOperand &a, const AsmOperand &b, AsmCode &s) {
+    emit_instr(op, a, s);
+    s.back().args.push_back(b);
+}
+
+static void emit_instr(const char *op, const AsmOperand &a, const AsmOperand &b, const AsmOperand &c,
+                       AsmCode &s) {
+    emit_instr(op, a, b, s);
+    s.back().args.push_back(c);
+}
+
+static void emit_instr(const char *op, const AsmOperand &a, const AsmOperand &b, const AsmOperand &c,
+                       const AsmOperand &d, AsmCode &s) {
+    emit_instr(op, a, b, c, s);
+    s.back().args.push_back(d);
+}
+
+static void emit_mov(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(MOV, source, dest, s);
+}
+
+static void emit_rmmov(const char *source_reg, int offset, const char *base_reg, AsmCode &s) {
+    emit_instr(MOV, asm_reg(source_reg), asm_mem(base_reg, offset), s);
+}
+
+static void emit_mrmov(const char *base_reg, int offset, const char *dest_reg, AsmCode &s) {
+    emit_instr(MOV, asm_mem(base_reg, offset), asm_reg(dest_reg), s);
+}
+
+static void emit_irmov(long long immidiate, const char *dest_reg, AsmCode &s) {
+    emit_instr(MOV, asm_imm(immidiate), asm_reg(dest_reg), s);
+}
+
+static void emit_irmovl(long long immidiate, const char *dest_reg, AsmCode &s) {
+    emit_instr(MOVL, asm_imm(immidiate), asm_reg(dest_reg), s);
+}
+
+static void emit_immov(long long immidiate, int offset, const char *base_reg, AsmCode &s) {
+    emit_instr(MOV, asm_imm(immidiate), asm_mem(base_reg, offset), s);
+}
+
+static void emit_add(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(ADD, source, dest, s);
+}
+
+static void emit_sub(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SUB, source, dest, s);
+}
+
+static void emit_mul(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(MUL, source, dest, s);
+}
+
+static void emit_div(const AsmOperand &source, AsmCode &s) {
+    emit_instr(DIV, source, s);
 }
 
-static void emit_rmmov(const char *source_reg, int offset, const char *base_reg, ostream &s) {
-    s << MOV << source_reg << COMMA << offset << "(" << base_reg << ")"
-      << endl;
+static void emit_cqto(AsmCode &s) {
+    emit_instr(CQTO, s);
 }
 
-static void emit_mrmov(const char *base_reg, int offset, const char *dest_reg, ostream &s) {
-    s << MOV << offset << "(" << base_reg << ")" << COMMA << dest_reg
-      << endl;
+static void emit_neg(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(NEG, dest, s);
 }
 
-static void emit_irmov(const char *immidiate, const char *dest_reg, ostream &s) {
-    s << MOV << "$" << immidiate << COMMA << dest_reg
-      << endl;
+static void emit_and(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(AND, source, dest, s);
 }
 
-static void emit_irmovl(const char *immidiate, const char *dest_reg, ostream &s) {
-    s << MOVL << "$" << immidiate << COMMA << dest_reg
-      << endl;
+static void emit_or(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(OR, source, dest, s);
 }
 
-static void emit_immov(const char *immidiate, int offset, const char *base_reg, ostream &s) {
-    s << MOV << "$" << immidiate << COMMA << "(" << offset << ")" << base_reg
-      << endl;
+static void emit_xor(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(XOR, source, dest, s);
 }
 
-static void emit_add(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << ADD << source_reg << COMMA << dest_reg << endl;
+static void emit_sal(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SAL, source, dest, s);
 }
 
-static void emit_sub(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << SUB << source_reg << COMMA << dest_reg << endl;
+static void emit_sar(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SAR, source, dest, s);
 }
 
-static void emit_mul(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << MUL << source_reg << COMMA << dest_reg << endl;
+static void emit_shr(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SHR, source, dest, s);
 }
 
-static void emit_div(const char *dest_reg, ostream &s) {
-    s << DIV << dest_reg << endl;
+// dest_reg = base_reg + index_reg * scale
+static void emit_lea(const char *base_reg, const char *index_reg, int scale, const char *dest_reg, AsmCode &s) {
+    emit_instr(LEA, asm_indexed(base_reg, index_reg, scale), asm_reg(dest_reg), s);
 }
 
-static void emit_cqto(ostream &s) {
-    s << CQTO << endl;
+// %rdx:%rax = %rax * source
+static void emit_mul_wide(const AsmOperand &source, AsmCode &s) {
+    emit_instr(MUL, source, s);
 }
 
-static void emit_neg(const char *dest_reg, ostream &s) {
-    s << NEG << dest_reg << endl;
+static void emit_not(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(NOT, dest, s);
 }
 
-static void emit_and(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << AND << source_reg << COMMA << dest_reg << endl;
+static void emit_movsd(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    if (!curr_vex) emit_instr(MOVSD, source, dest, s);
+    // vmovsd between registers would merge in the upper half of dest
+    else if (is_xmm(source) && is_xmm(dest)) emit_instr(VMOVAPD, source, dest, s);
+    else emit_instr(VMOVSD, source, dest, s);
 }
 
-static void emit_or(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << OR << source_reg << COMMA << dest_reg << endl;
+static void emit_movaps(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(curr_vex ? VMOVAPS : MOVAPS, source, dest, s);
 }
 
-static void emit_xor(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << XOR << source_reg << COMMA << dest_reg << endl;
+// the SSE form, or the VEX one with dest as the first source too
+static void emit_float_arith(const char *sse, const char *vex, const AsmOperand &source, const AsmOperand &dest,
+                             AsmCode &s) {
+    if (curr_vex) emit_instr(vex, source, dest, dest, s);
+    else emit_instr(sse, source, dest, s);
 }
 
-static void emit_not(const char *dest_reg, ostream &s) {
-    s << NOT << " " << dest_reg << endl;
+static void emit_addsd(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_float_arith(ADDSD, VADDSD, source, dest, s);
 }
 
-static void emit_movsd(const char *source, const char *dest, ostream &s) {
-    s << MOVSD << source << COMMA << dest << endl;
+static void emit_subsd(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_float_arith(SUBSD, VSUBSD, source, dest, s);
 }
 
-static void emit_movaps(const char *source, const char *dest, ostream &s) {
-    s << MOVAPS << source << COMMA << dest << endl;
+static void emit_mulsd(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_float_arith(MULSD, VMULSD, source, dest, s);
 }
 
-static void emit_addsd(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << ADDSD << source_reg << COMMA << dest_reg << endl;
+static void emit_divsd(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_float_arith(DIVSD, VDIVSD, source, dest, s);
 }
 
-static void emit_subsd(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << SUBSD << source_reg << COMMA << dest_reg << endl;
+static void emit_movapd(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(MOVAPD, source, dest, s);
 }
 
-static void emit_mulsd(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << MULSD << source_reg << COMMA << dest_reg << endl;
+static void emit_movhpd(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(MOVHPD, source, dest, s);
 }
 
-static void emit_divsd(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << DIVSD << source_reg << COMMA << dest_reg << endl;
+static void emit_unpcklpd(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(UNPCKLPD, source, dest, s);
 }
 
-static void emit_cmp(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << CMP << source_reg << COMMA << dest_reg << endl;
+static void emit_unpckhpd(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(UNPCKHPD, source, dest, s);
 }
 
-static void emit_test(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << TEST << source_reg << COMMA << dest_reg << endl;
+// dest = source2 op source1, VEX operand order
+static void emit_vex3(const char *op, const AsmOperand &source1, const AsmOperand &source2, const AsmOperand &dest,
+                      AsmCode &s) {
+    emit_instr(op, source1, source2, dest, s);
 }
 
-static void emit_ucompisd(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << UCOMPISD << source_reg << COMMA << dest_reg << endl;
+static void emit_vbroadcastsd(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(VBROADCASTSD, source, dest, s);
 }
 
-static void emit_xorpd(const char *source_reg, const char *dest_reg, ostream &s) {
-    s << XORPD << source_reg << COMMA << dest_reg << endl;
+static void emit_vinsertf128(const AsmOperand &source, const AsmOperand &high, const AsmOperand &dest,
+                             AsmCode &s) {
+    emit_instr(VINSERTF128, asm_imm(1), source, high, dest, s);
 }
 
-static void emit_jmp(const char *dest, ostream &s) {
-    s << JMP << " " << dest << endl;
+static void emit_vextractf128(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(VEXTRACTF128, asm_imm(1), source, dest, s);
 }
 
-static void emit_jl(const char *dest, ostream &s) {
-    s << JL << " " << dest << endl;
+static void emit_vzeroupper(AsmCode &s) {
+    emit_instr(VZEROUPPER, s);
 }
 
-static void emit_jle(const char *dest, ostream &s) {
-    s << JLE << " " << dest << endl;
+static void emit_cmp(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(CMP, source, dest, s);
 }
 
-static void emit_je(const char *dest, ostream &s) {
-    s << JE << " " << dest << endl;
+static void emit_test(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(TEST, source, dest, s);
 }
 
-static void emit_jne(const char *dest, ostream &s) {
-    s << JNE << " " << dest << endl;
+static void emit_ucompisd(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(UCOMPISD, source, dest, s);
 }
 
-static void emit_jg(const char *dest, ostream &s) {
-    s << JG << " " << dest << endl;
+static void emit_xorpd(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(XORPD, source, dest, s);
 }
 
-static void emit_jge(const char *dest, ostream &s) {
-    s << JGE << " " << dest << endl;
+static void emit_jmp(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JMP, dest, s);
 }
 
-static void emit_jb(const char *dest, ostream &s) {
-    s << JB << " " << dest << endl;
+static void emit_jl(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JL, dest, s);
 }
 
-static void emit_jbe(const char *dest, ostream &s) {
-    s << JBE << " " << dest << endl;
+static void emit_jle(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JLE, dest, s);
 }
 
-static void emit_ja(const char *dest, ostream &s) {
-    s << JA << " " << dest << endl;
+static void emit_je(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JE, dest, s);
 }
 
-static void emit_jae(const char *dest, ostream &s) {
-    s << JAE << " " << dest << endl;
+static void emit_jne(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JNE, dest, s);
 }
 
-static void emit_jp(const char *dest, ostream &s) {
-    s << JP << " " << dest << endl;
+static void emit_jg(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JG, dest, s);
 }
 
-static void emit_jz(const char *dest, ostream &s) {
-    s << JZ << " " << dest << endl;
+static void emit_jge(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JGE, dest, s);
 }
 
-static void emit_jnz(const char *dest, ostream &s) {
-    s << JNZ << " " << dest << endl;
+static void emit_jb(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JB, dest, s);
 }
 
-static void emit_call(const char *dest, ostream &s) {
-    s << CALL << " " << dest << endl;
+static void emit_jbe(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JBE, dest, s);
 }
 
-static void emit_ret(ostream &s) {
-    s << RET << endl;
+static void emit_ja(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JA, dest, s);
 }
 
-static void emit_push(const char *reg, ostream &s) {
-    s << PUSH << " " << reg << endl;
+static void emit_jae(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JAE, dest, s);
 }
 
-static void emit_pop(const char *reg, ostream &s) {
-    s << POP << " " << reg << endl;
+static void emit_jp(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JP, dest, s);
 }
 
-static void emit_leave(ostream &s) {
-    s << LEAVE << endl;
+static void emit_setl(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SETL, dest, s);
 }
 
-static void emit_position(const char *p, ostream &s) {
-    s << p << ":" << endl;
+static void emit_setle(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SETLE, dest, s);
 }
 
-static void emit_float_to_int(const char *float_mmx, const char *int_reg, ostream &s) {
-    s << CVTTSD2SIQ << float_mmx << COMMA << int_reg << endl;
+static void emit_sete(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SETE, dest, s);
 }
 
-static void emit_int_to_float(const char *int_reg, const char *float_mmx, ostream &s) {
-    s << CVTSI2SDQ << int_reg << COMMA << float_mmx << endl;
+static void emit_setne(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SETNE, dest, s);
+}
+
+static void emit_setg(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SETG, dest, s);
+}
+
+static void emit_setge(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SETGE, dest, s);
+}
+
+static void emit_seta(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SETA, dest, s);
+}
+
+static void emit_setae(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SETAE, dest, s);
+}
+
+static void emit_setb(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SETB, dest, s);
+}
+
+static void emit_setbe(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SETBE, dest, s);
+}
+
+static void emit_setp(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SETP, dest, s);
+}
+
+static void emit_setnp(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(SETNP, dest, s);
+}
+
+static void emit_andb(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(ANDB, source, dest, s);
+}
+
+static void emit_orb(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(ORB, source, dest, s);
+}
+
+static void emit_movzbq(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(MOVZBQ, source, dest, s);
+}
+
+static void emit_jz(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JZ, dest, s);
+}
+
+static void emit_jnz(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(JNZ, dest, s);
+}
+
+static void emit_call(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(CALL, dest, s);
+}
+
+static void emit_ret(AsmCode &s) {
+    emit_instr(RET, s);
+}
+
+static void emit_push(const AsmOperand &source, AsmCode &s) {
+    emit_instr(PUSH, source, s);
+}
+
+static void emit_pop(const AsmOperand &dest, AsmCode &s) {
+    emit_instr(POP, dest, s);
+}
+
+static void emit_leave(AsmCode &s) {
+    emit_instr(LEAVE, s);
+}
+
+static void emit_position(const AsmOperand &label, AsmCode &s) {
+    emit_instr(NULL, label, s);
+}
+
+static void emit_float_to_int(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    emit_instr(CVTTSD2SIQ, source, dest, s);
+}
+
+static void emit_int_to_float(const AsmOperand &source, const AsmOperand &dest, AsmCode &s) {
+    if (curr_vex) emit_instr(VCVTSI2SDQ, source, dest, dest, s);
+    else emit_instr(CVTSI2SDQ, source, dest, s);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -357,15 +540,59 @@ void StringEntry::code_def(ostream &s) {
 // stringtable.
 //
 void StrTable::code_string_table(ostream &s) {
-    for (List<StringEntry> *l = tbl; l; l = l->tl())
-        l->hd()->code_def(s);
+    for (int i = first(); more(i); i = next(i))
+        lookup(i)->code_def(s);
 }
 
-// the following 2 functions are useless, please DO NOT care about them
+//
+// Floats
+//
+// A FloatEntry made by the code generator holds the bit pattern of a
+// double as "0x..."; the entries the lexer makes for literals are
+// never referenced.  Each distinct double gets one .FL constant.
+//
+static vector<int> float_consts;        // indices of the referenced entries, in order
+static vector<bool> float_referenced;   // by entry index
+
 void FloatEntry::code_ref(ostream &s) {
-    s << FLOATTAG << index;
+    s << FLOATCONST_PREFIX << index;
+}
+
+void FloatEntry::code_def(ostream &s) {
+    s << FLOATCONST_PREFIX << index << ":" << endl;
+    // the bit pattern of the double
+    s << INTTAG << str << endl;
+}
+
+//
+// FloatTable::code_string_table
+// Generate a definition for every float constant the code refers to.
+//
+void FloatTable::code_string_table(ostream &s) {
+    if (float_consts.empty()) return;
+    s << SECTION << RODATA << endl;
+    s << ALIGN << 8 << endl;
+    for (unsigned int i = 0; i < float_consts.size(); ++i)
+        lookup(float_consts[i])->code_def(s);
+}
+
+// the index of the .FL constant holding value
+static int float_const(double value) {
+    char bits[OPERAND_SIZE];
+    unsigned long long pattern;
+    memcpy(&pattern, &value, sizeof(pattern));
+    sprintf(bits, "0x%016llx", pattern);
+    int index = floattable.add_string(bits)->get_index();
+    if (index >= (int) float_referenced.size()) float_referenced.resize(index + 1, false);
+    if (!float_referenced[index]) {
+        float_referenced[index] = true;
+        float_consts.push_back(index);
+    }
+    return index;
 }
 
+// the following function is useless, please DO NOT care about it
+
 void IntEntry::code_def(ostream &s) {
     s << GLOBAL;
 }
@@ -408,41 +635,985 @@ static bool sameType(Symbol name1, Symbol name2) {
     return strcmp(name1->get_string(), name2->get_string()) == 0;
 }
 
-int count_len_addr_reg_shift(const char *const reg, const int deviation) {
-    if (deviation == 0) {
-        return strlen(reg);
-    } else if (deviation < 0) return -1;
-    int tmp = deviation;
-    int digit = 0;
-    while (tmp != 0) {
-        ++digit;
-        tmp /= 10;
+//////////////////////////////////////////////////////////////////
+//
+//    Lowering helpers
+//
+//    The code() methods below lower the AST into the IR of the
+//    function being compiled (curr_fn).  An expression leaves the
+//    operand holding its value on operandStack.
+//
+//////////////////////////////////////////////////////////////////
+
+static void ir_emit(const IrInstr &instr) {
+    curr_fn->blocks[curr_block].instrs.push_back(instr);
+}
+
+static IrOperand new_value(bool is_float) {
+    return ir_vreg(curr_fn->new_vreg(is_float), is_float);
+}
+
+static IrOperand pop_operand() {
+    IrOperand o = operandStack.top();
+    operandStack.pop();
+    return o;
+}
+
+// true once the current block has its terminator, e.g. after `return`
+static bool block_closed() {
+    vector<IrInstr> &instrs = curr_fn->blocks[curr_block].instrs;
+    return !instrs.empty() && instrs.back().is_terminator();
+}
+
+// end the current block with a jump unless it is already closed
+static void close_block(int target) {
+    if (!block_closed()) ir_emit(ir_jmp(target));
+}
+
+// code after return/break/continue goes to a fresh block no edge reaches
+static void start_unreachable_block() {
+    curr_block = curr_fn->new_block();
+}
+
+static IrOperand as_float(IrOperand o) {
+    if (o.is_float) return o;
+    if (o.kind == IR_IMM) return ir_fimm((double) o.imm);
+    IrOperand res = new_value(true);
+    ir_emit(ir_unary(IR_I2F, res, o));
+    return res;
+}
+
+// drop the operands a statement left behind, e.g. the value of `a = b;`
+static void discard_operands(unsigned int depth) {
+    while (operandStack.size() > depth) operandStack.pop();
+}
+
+// e1 op e2 for + - * /, promoting to Float when either side is Float
+static void code_arith(Expr e1, Expr e2, IrOpcode int_op, IrOpcode float_op, ostream &s) {
+    // caution: their order
+    e1->code(s);
+    e2->code(s);
+    IrOperand b = pop_operand();
+    IrOperand a = pop_operand();
+    IrOperand res;
+    if (a.is_float || b.is_float) {
+        a = as_float(a);
+        b = as_float(b);
+        res = new_value(true);
+        ir_emit(ir_binary(float_op, res, a, b));
+    } else {
+        res = new_value(false);
+        ir_emit(ir_binary(int_op, res, a, b));
+    }
+    operandStack.push(res);
+}
+
+// e1 op e2 on Int and Bool values
+static void code_logic(Expr e1, Expr e2, IrOpcode op, ostream &s) {
+    // caution: their order
+    e1->code(s);
+    e2->code(s);
+    IrOperand b = pop_operand();
+    IrOperand a = pop_operand();
+    IrOperand res = new_value(false);
+    ir_emit(ir_binary(op, res, a, b));
+    operandStack.push(res);
+}
+
+// e1 cmp e2, comparing as Float when either side is Float
+static void code_compare(Expr e1, Expr e2, IrOpcode op, ostream &s) {
+    // caution: their order
+    e1->code(s);
+    e2->code(s);
+    IrOperand b = pop_operand();
+    IrOperand a = pop_operand();
+    if (a.is_float || b.is_float) {
+        a = as_float(a);
+        b = as_float(b);
+    }
+    IrOperand res = new_value(false);
+    ir_emit(ir_binary(op, res, a, b));
+    operandStack.push(res);
+}
+
+// lower e as a condition: jump to on_true if it holds, else to on_false
+static void code_condition(Expr e, int on_true, int on_false, ostream &s) {
+    // && || and ! branch on their operands instead of computing a Bool
+    if (And_class *and_expr = dynamic_cast<And_class *>(e)) {
+        and_expr->code_branch(on_true, on_false, s);
+        return;
+    }
+    if (Or_class *or_expr = dynamic_cast<Or_class *>(e)) {
+        or_expr->code_branch(on_true, on_false, s);
+        return;
+    }
+    if (Not_class *not_expr = dynamic_cast<Not_class *>(e)) {
+        not_expr->code_branch(on_true, on_false, s);
+        return;
+    }
+    e->code(s);
+    IrOperand c = pop_operand();
+    // an empty condition always holds
+    if (c.kind == IR_NONE) ir_emit(ir_jmp(on_true));
+    else ir_emit(ir_br(c, on_true, on_false));
+}
+
+// a short-circuit condition used as a value: 1 or 0
+static void code_condition_value(Expr e, ostream &s) {
+    int true_block = curr_fn->new_block();
+    int false_block = curr_fn->new_block();
+    int next_block = curr_fn->new_block();
+    IrOperand res = new_value(false);
+    code_condition(e, true_block, false_block, s);
+
+    curr_block = true_block;
+    ir_emit(ir_mov(res, ir_imm(1)));
+    close_block(next_block);
+
+    curr_block = false_block;
+    ir_emit(ir_mov(res, ir_imm(0)));
+    close_block(next_block);
+
+    curr_block = next_block;
+    operandStack.push(res);
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    Instruction selection
+//
+//    Walks the IR of a function after register allocation and
+//    records x86-64 instructions.  %rax, %rcx, %rdx, %xmm4 and %xmm5
+//    are scratch.  Machine operands are AsmOperand values; they
+//    become text only when the function is written out.
+//
+//////////////////////////////////////////////////////////////////
+
+static const IrAllocation *curr_alloc;  // locations of the function being selected
+static int block_pos_base;              // .POS number of block 0
+
+// an immediate that only movq to a register can take
+static bool is_wide_imm(const AsmOperand &o) {
+    return o.kind == ASM_IMM && (o.imm < -2147483648LL || o.imm > 2147483647LL);
+}
+
+//
+// The frame of the function being selected.  Only the callee-saved
+// registers the allocation hands out are saved.  A function that makes
+// no call sets up no %rbp: its slots sit below %rsp, in the 128-byte
+// red zone when they fit.
+//
+struct FrameLayout {
+    bool has_fp;                  // %rbp points at the saved %rbp
+    vector<const char *> saved;   // callee-saved registers, in push order
+    int reserved;                 // bytes subtracted from %rsp below them
+};
+
+static FrameLayout curr_frame;
+static char **curr_int_regs;      // ALLOC_REGS or LEAF_ALLOC_REGS
+static vector<const char *> curr_call_saves;  // caller-saved registers live across the call being selected
+static int curr_lanes;             // doubles in a packed register: 2 in xmm, 4 in ymm
+
+#define RED_ZONE 128
+
+static bool is_callee_saved(const char *reg) {
+    for (int r = 0; r < CALLEE_SAVED_REGS; ++r)
+        if (strcmp(ALLOC_REGS[r], reg) == 0) return true;
+    return false;
+}
+
+static AsmOperand slot_operand(int slot) {
+    if (curr_frame.has_fp) return asm_mem(RBP, -8 * ((int) curr_frame.saved.size() + slot + 1));
+    return asm_mem(RSP, curr_frame.reserved - 8 * (slot + 1));
+}
+
+// where an IR operand lives
+static AsmOperand machine_operand(const IrOperand &o) {
+    switch (o.kind) {
+        case IR_VREG: {
+            const IrLocation &loc = curr_alloc->loc[o.vreg];
+            if (loc.in_reg) return asm_reg(o.is_float ? ALLOC_XMM[loc.reg] : curr_int_regs[loc.reg]);
+            return slot_operand(loc.slot);
+        }
+        case IR_IMM:
+            return asm_imm(o.imm);
+        case IR_FIMM: {
+            // loaded from the float pool
+            AsmOperand res = asm_operand(ASM_CONST);
+            res.name = FLOATCONST_PREFIX;
+            res.imm = float_const(o.fimm);
+            return res;
+        }
+        case IR_GLOBAL: {
+            AsmOperand res = asm_operand(ASM_GLOBAL);
+            res.name = o.name;
+            return res;
+        }
+        case IR_STRING: {
+            AsmOperand res = asm_operand(ASM_LABEL);
+            res.name = STRINGCONST_PREFIX;
+            res.imm = o.imm;
+            return res;
+        }
+        default:
+            return asm_operand(ASM_NONE);
+    }
+}
+
+static AsmOperand block_label(int block) {
+    return asm_block(POSITION, block_pos_base + block);
+}
+
+// move between any two operands, through %rax when x86 has no direct form
+static void emit_load(const AsmOperand &src, const AsmOperand &dst, AsmCode &s) {
+    if (same_operand(src, dst)) return;
+    AsmOperand rax = asm_reg(RAX);
+    if (is_xmm(dst)) {
+        if (is_imm(src)) {
+            emit_mov(src, rax, s);
+            emit_mov(rax, dst, s);
+        }
+        else if (is_xmm(src) || is_mem(src)) emit_movsd(src, dst, s);
+        else emit_mov(src, dst, s);
+    }
+    else if (is_reg(dst)) emit_mov(src, dst, s);
+    else {
+        if (is_mem(src) || is_wide_imm(src)) {
+            emit_load(src, rax, s);
+            emit_load(rax, dst, s);
+        }
+        else if (is_xmm(src)) emit_movsd(src, dst, s);
+        else emit_mov(src, dst, s);
+    }
+}
+
+// an operand the instruction can take directly, else a copy in scratch
+static AsmOperand in_reg_unless(bool direct, const AsmOperand &o, const char *scratch, AsmCode &s) {
+    if (direct) return o;
+    emit_load(o, asm_reg(scratch), s);
+    return asm_reg(scratch);
+}
+
+static void emit_int_op(IrOpcode op, const AsmOperand &src, const AsmOperand &dst, AsmCode &s) {
+    switch (op) {
+        case IR_ADD: emit_add(src, dst, s); break;
+        case IR_SUB: emit_sub(src, dst, s); break;
+        case IR_MUL: emit_mul(src, dst, s); break;
+        case IR_AND: emit_and(src, dst, s); break;
+        case IR_OR: emit_or(src, dst, s); break;
+        case IR_XOR: emit_xor(src, dst, s); break;
+        default: break;
+    }
+}
+
+static void emit_float_op(IrOpcode op, const AsmOperand &src, const AsmOperand &dst, AsmCode &s) {
+    switch (op) {
+        case IR_FADD: emit_addsd(src, dst, s); break;
+        case IR_FSUB: emit_subsd(src, dst, s); break;
+        case IR_FMUL: emit_mulsd(src, dst, s); break;
+        case IR_FDIV: emit_divsd(src, dst, s); break;
+        default: break;
+    }
+}
+
+// restore previous workspace, leaving %rsp at the return address
+static void emit_leave_frame(AsmCode &s) {
+    const vector<const char *> &saved = curr_frame.saved;
+    if (curr_frame.has_fp && curr_frame.reserved > 0) {
+        // read them back relative to %rbp, below them is the frame
+        for (int i = saved.size() - 1; i >= 0; --i)
+            emit_mrmov(RBP, -8 * (i + 1), saved[i], s);
+        emit_leave(s);
+        return;
+    }
+    if (curr_frame.reserved > 0) emit_add(asm_imm(curr_frame.reserved), asm_reg(RSP), s);
+    // %rsp is back at the last saved register
+    for (int i = saved.size() - 1; i >= 0; --i)
+        emit_pop(asm_reg(saved[i]), s);
+    if (curr_frame.has_fp) emit_pop(asm_reg(RBP), s);
+}
+
+// restore previous workspace and go back
+static void emit_epilogue(AsmCode &s) {
+    emit_leave_frame(s);
+    emit_ret(s);
+}
+
+// what a float compare means when either side is NaN (parity flag set)
+enum ParityRule {
+    PARITY_IGNORED,   // the condition already fails on unordered
+    PARITY_FALSE,     // ==: unordered is false
+    PARITY_TRUE       // !=: unordered is true
+};
+
+// the flags condition a compare leaves behind
+struct CondCode {
+    void (*jump)(const AsmOperand &, AsmCode &);       // taken if true
+    void (*jump_not)(const AsmOperand &, AsmCode &);   // taken if false
+    void (*set)(const AsmOperand &, AsmCode &);        // byte = condition
+    ParityRule parity;
+};
+
+static CondCode cond_code(void (*jump)(const AsmOperand &, AsmCode &), void (*jump_not)(const AsmOperand &, AsmCode &),
+                          void (*set)(const AsmOperand &, AsmCode &), ParityRule parity) {
+    CondCode cc;
+    cc.jump = jump;
+    cc.jump_not = jump_not;
+    cc.set = set;
+    cc.parity = parity;
+    return cc;
+}
+
+// compare the operands of instr and return the condition to test
+static CondCode emit_compare_flags(const IrInstr &instr, AsmCode &s) {
+    AsmOperand a = machine_operand(instr.a);
+    AsmOperand b = machine_operand(instr.b);
+    if (instr.a.is_float) {
+        // ucomisd sets the flags like an unsigned compare of its xmm destination with its source,
+        // so < and <= are turned around to become > and >=, which also fail on unordered
+        bool swap = instr.op == IR_LT || instr.op == IR_LE;
+        AsmOperand lhs = in_reg_unless(is_xmm(swap ? b : a), swap ? b : a, XMM5, s);
+        AsmOperand rhs = in_reg_unless(!is_imm(swap ? a : b), swap ? a : b, XMM4, s);
+        emit_ucompisd(rhs, lhs, s);
+        switch (instr.op) {
+            case IR_LT:
+            case IR_GT: return cond_code(emit_ja, emit_jbe, emit_seta, PARITY_IGNORED);
+            case IR_LE:
+            case IR_GE: return cond_code(emit_jae, emit_jb, emit_setae, PARITY_IGNORED);
+            case IR_EQ: return cond_code(emit_je, emit_jne, emit_sete, PARITY_FALSE);
+            default: return cond_code(emit_jne, emit_je, emit_setne, PARITY_TRUE);
+        }
+    }
+    AsmOperand rhs = in_reg_unless(!is_wide_imm(b), b, RCX, s);
+    // cmpq takes neither an immediate destination nor two memory operands
+    AsmOperand lhs = in_reg_unless(!is_imm(a) && !(is_mem(a) && is_mem(rhs)), a, RAX, s);
+    emit_cmp(rhs, lhs, s);
+    switch (instr.op) {
+        case IR_LT: return cond_code(emit_jl, emit_jge, emit_setl, PARITY_IGNORED);
+        case IR_LE: return cond_code(emit_jle, emit_jg, emit_setle, PARITY_IGNORED);
+        case IR_GT: return cond_code(emit_jg, emit_jle, emit_setg, PARITY_IGNORED);
+        case IR_GE: return cond_code(emit_jge, emit_jl, emit_setge, PARITY_IGNORED);
+        case IR_EQ: return cond_code(emit_je, emit_jne, emit_sete, PARITY_IGNORED);
+        default: return cond_code(emit_jne, emit_je, emit_setne, PARITY_IGNORED);
+    }
+}
+
+// materialise a comparison result without branching: dst = 0 or 1
+static void select_compare(const IrInstr &instr, const AsmOperand &d, AsmCode &s) {
+    AsmOperand al = asm_reg(AL), cl = asm_reg(CL);
+    CondCode cc = emit_compare_flags(instr, s);
+    cc.set(al, s);
+    if (cc.parity == PARITY_FALSE) {
+        emit_setnp(cl, s);
+        emit_andb(cl, al, s);
+    }
+    else if (cc.parity == PARITY_TRUE) {
+        emit_setp(cl, s);
+        emit_orb(cl, al, s);
+    }
+    if (d.kind == ASM_REG) emit_movzbq(al, d, s);
+    else {
+        emit_movzbq(al, asm_reg(RAX), s);
+        emit_load(asm_reg(RAX), d, s);
+    }
+}
+
+// a compare whose only use is the branch right after it: test the flags directly
+static void select_compare_branch(const IrInstr &cmp, const IrInstr &br, int next_block, AsmCode &s) {
+    AsmOperand on_true = block_label(br.target), on_false = block_label(br.target2);
+    CondCode cc = emit_compare_flags(cmp, s);
+    if (br.target == next_block) {
+        // fall into the true block
+        if (cc.parity == PARITY_FALSE) emit_jp(on_false, s);
+        if (cc.parity == PARITY_TRUE) emit_jp(on_true, s);
+        cc.jump_not(on_false, s);
+        return;
+    }
+    if (cc.parity == PARITY_FALSE) emit_jp(on_false, s);
+    if (cc.parity == PARITY_TRUE) emit_jp(on_true, s);
+    cc.jump(on_true, s);
+    if (br.target2 != next_block) emit_jmp(on_false, s);
+}
+
+// the arguments past the registers of their class, which go on the stack
+static void stack_args(const vector<IrOperand> &args, vector<IrOperand> &res) {
+    int int_num = 0;
+    int float_num = 0;
+    res.clear();
+    for (unsigned int i = 0; i < args.size(); ++i) {
+        if (args[i].is_float ? float_num++ < CALL_XMM_COUNT : int_num++ < CALL_REG_COUNT) continue;
+        res.push_back(args[i]);
+    }
+}
+
+static bool needs_stack_args(const IrInstr &instr) {
+    vector<IrOperand> args;
+    stack_args(instr.args, args);
+    return !args.empty();
+}
+
+// push the stack arguments of a call, the first one last, and return
+// the bytes pushed; %rsp stays 16-byte aligned
+static int emit_push_args(const IrInstr &instr, AsmCode &s) {
+    vector<IrOperand> args;
+    stack_args(instr.args, args);
+    if (args.empty()) return 0;
+    AsmOperand rsp = asm_reg(RSP);
+    if (args.size() % 2) emit_sub(asm_imm(8), rsp, s);
+    for (int i = args.size() - 1; i >= 0; --i) {
+        AsmOperand a = machine_operand(args[i]);
+        if (is_xmm(a)) {
+            emit_sub(asm_imm(8), rsp, s);
+            emit_movsd(a, asm_mem(RSP, 0), s);
+            continue;
+        }
+        if (is_wide_imm(a)) {
+            emit_load(a, asm_reg(RAX), s);
+            a = asm_reg(RAX);
+        }
+        emit_push(a, s);
+    }
+    return (args.size() + 1) / 2 * 16;
+}
+
+// put the register arguments of a call where the callee expects them
+static void emit_call_args(const IrInstr &instr, AsmCode &s) {
+    int int_num = 0;
+    int float_num = 0;
+    for (unsigned int i = 0; i < instr.args.size(); ++i) {
+        AsmOperand a = machine_operand(instr.args[i]);
+        if (instr.args[i].is_float) {
+            if (float_num < CALL_XMM_COUNT) emit_load(a, asm_reg(CALL_XMM[float_num]), s);
+            ++float_num;
+        }
+        else if (int_num < CALL_REG_COUNT) emit_load(a, asm_reg(CALL_REGS[int_num++]), s);
+    }
+    if (float_num > CALL_XMM_COUNT) float_num = CALL_XMM_COUNT;
+    // please set %eax to the number of Float parameters, num.
+    if (strcmp(instr.callee, print->get_string()) == 0) emit_irmovl(float_num, EAX, s);
+}
+
+static void select_call(const IrInstr &instr, const AsmOperand &d, AsmCode &s) {
+    // store the workspace (caller reg) that holds live values, keeping %rsp aligned
+    AsmOperand save_size = asm_imm((8 * curr_call_saves.size() + 15) / 16 * 16);
+    AsmOperand rsp = asm_reg(RSP);
+    if (!curr_call_saves.empty()) emit_sub(save_size, rsp, s);
+    for (unsigned int r = 0; r < curr_call_saves.size(); ++r)
+        emit_load(asm_reg(curr_call_saves[r]), asm_mem(RSP, 8 * r), s);
+    // the arguments, below the saved registers
+    int pushed = emit_push_args(instr, s);
+    emit_call_args(instr, s);
+    emit_call(asm_symbol(instr.callee), s);
+    if (pushed > 0) emit_add(asm_imm(pushed), rsp, s);
+    // restore workspace
+    for (unsigned int r = 0; r < curr_call_saves.size(); ++r)
+        emit_load(asm_mem(RSP, 8 * r), asm_reg(curr_call_saves[r]), s);
+    if (!curr_call_saves.empty()) emit_add(save_size, rsp, s);
+    // get the result
+    if (instr.has_dst()) emit_load(asm_reg(RAX), d, s);
+}
+
+//
+// Multiplication and division by a constant.
+//
+// Multiplying by c = m * 2^k with m in {1, 3, 5, 9} is a lea and a
+// shift.  Dividing by 2^k adds 2^k - 1 to negative dividends before
+// the arithmetic shift, so the quotient truncates towards zero as
+// idivq's does.  Other divisors multiply by a magic reciprocal and
+// keep the high half (Hacker's Delight, 10-4).
+//
+
+static int log2_exact(unsigned long long c) {
+    if (c == 0 || (c & (c - 1)) != 0) return -1;
+    int k = 0;
+    while (c >>= 1) ++k;
+    return k;
+}
+
+static bool select_mul_const(const IrInstr &instr, const AsmOperand &d, AsmCode &s) {
+    const IrOperand *x = &instr.a, *c = &instr.b;
+    if (x->kind == IR_IMM) std::swap(x, c);
+    if (c->kind != IR_IMM || x->kind == IR_IMM || c->imm == (long long) (1ULL << 63)) return false;
+    unsigned long long mag = c->imm < 0 ? -c->imm : c->imm;
+    int k = 0;
+    while (mag != 0 && (mag & 1) == 0) {
+        mag >>= 1;
+        ++k;
     }
-    return strlen(reg) + digit + 4;
+    if (mag != 0 && mag != 1 && mag != 3 && mag != 5 && mag != 9) return false;
+
+    AsmOperand reg = d.kind == ASM_REG ? d : asm_reg(RAX);
+    if (mag == 0) emit_load(asm_imm(0), reg, s);
+    else {
+        emit_load(machine_operand(*x), reg, s);
+        if (mag > 1) emit_lea(reg.reg, reg.reg, mag - 1, reg.reg, s);
+        if (k > 0) emit_sal(asm_imm(k), reg, s);
+        if (c->imm < 0) emit_neg(reg, s);
+    }
+    emit_load(reg, d, s);
+    return true;
+}
+
+// multiplier and shift for signed division by d, |d| >= 2
+static void magic_divisor(long long d, long long &multiplier, int &shift) {
+    const unsigned long long two63 = 1ULL << 63;
+    unsigned long long ad = d < 0 ? -(unsigned long long) d : d;
+    unsigned long long t = two63 + ((unsigned long long) d >> 63);
+    unsigned long long anc = t - 1 - t % ad;
+    unsigned long long q1 = two63 / anc, r1 = two63 - q1 * anc;
+    unsigned long long q2 = two63 / ad, r2 = two63 - q2 * ad;
+    unsigned long long delta;
+    int p = 63;
+    do {
+        ++p;
+        q1 *= 2;
+        r1 *= 2;
+        if (r1 >= anc) {
+            ++q1;
+            r1 -= anc;
+        }
+        q2 *= 2;
+        r2 *= 2;
+        if (r2 >= ad) {
+            ++q2;
+            r2 -= ad;
+        }
+        delta = ad - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+    multiplier = q2 + 1;
+    if (d < 0) multiplier = -multiplier;
+    shift = p - 64;
+}
+
+static bool select_div_const(const IrInstr &instr, const AsmOperand &d, AsmCode &s) {
+    long long c = instr.b.imm;
+    // -1 and 0 keep the fault of idivq
+    if (instr.b.kind != IR_IMM || instr.a.kind == IR_IMM || c == 0 || c == -1) return false;
+    AsmOperand x = machine_operand(instr.a);
+    AsmOperand rax = asm_reg(RAX), rdx = asm_reg(RDX);
+    if (c == 1) {
+        emit_load(instr.op == IR_DIV ? x : asm_imm(0), d, s);
+        return true;
+    }
+    unsigned long long mag = c < 0 ? -(unsigned long long) c : c;
+    int k = log2_exact(mag);
+    if (k > 0 && k < 32) {
+        // %rdx = 2^k - 1 for negative x, else 0
+        emit_load(x, rax, s);
+        emit_mov(rax, rdx, s);
+        emit_sar(asm_imm(63), rdx, s);
+        emit_shr(asm_imm(64 - k), rdx, s);
+        emit_add(rdx, rax, s);
+        if (instr.op == IR_DIV) {
+            emit_sar(asm_imm(k), rax, s);
+            if (c < 0) emit_neg(rax, s);
+        } else {
+            // the remainder takes the sign of x whatever the sign of c
+            emit_and(asm_imm(mag - 1), rax, s);
+            emit_sub(rdx, rax, s);
+        }
+        emit_load(rax, d, s);
+        return true;
+    }
+    if (k >= 0) return false;
+
+    long long multiplier;
+    int sh;
+    magic_divisor(c, multiplier, sh);
+    emit_mov(asm_imm(multiplier), rax, s);
+    emit_mul_wide(x, s);
+    if (c > 0 && multiplier < 0) emit_add(x, rdx, s);
+    if (c < 0 && multiplier > 0) emit_sub(x, rdx, s);
+    if (sh > 0) emit_sar(asm_imm(sh), rdx, s);
+    // round towards zero: add one to a negative quotient
+    emit_mov(rdx, rax, s);
+    emit_shr(asm_imm(63), rax, s);
+    emit_add(rax, rdx, s);
+    if (instr.op == IR_DIV) {
+        emit_load(rdx, d, s);
+        return true;
+    }
+    // x - q * c
+    AsmOperand factor = in_reg_unless(!is_wide_imm(asm_imm(c)), asm_imm(c), RAX, s);
+    emit_mul(factor, rdx, s);
+    emit_load(x, rax, s);
+    emit_sub(rdx, rax, s);
+    emit_load(rax, d, s);
+    return true;
 }
 
-static void addr_reg_shift(char *res, const char *const reg, const int deviation) {
-    if (deviation == 0) {
-        strcpy(res, reg);
+//
+// Packed values.  With two lanes they sit in xmm registers and take
+// SSE2 instructions; with four the same registers are named ymm and
+// take AVX ones, three-operand, so no copy of the first source is
+// needed.  A lane of a packed value reads as an ordinary Float.
+//
+
+static const char *YMM_REGS[] = {
+    "%ymm0", "%ymm1", "%ymm2", "%ymm3", "%ymm4", "%ymm5", "%ymm6", "%ymm7",
+    "%ymm8", "%ymm9", "%ymm10", "%ymm11", "%ymm12", "%ymm13", "%ymm14", "%ymm15"
+};
+
+// the register of a packed value, by its ymm name with four lanes
+static AsmOperand packed_operand(const AsmOperand &o) {
+    if (curr_lanes <= 2) return o;
+    return asm_reg(YMM_REGS[atoi(o.reg + strlen("%xmm"))]);
+}
+
+static const char *packed_op(IrOpcode op) {
+    bool vex = curr_lanes > 2;
+    switch (op) {
+        case IR_VFADD: return vex ? VADDPD : ADDPD;
+        case IR_VFSUB: return vex ? VSUBPD : SUBPD;
+        case IR_VFMUL: return vex ? VMULPD : MULPD;
+        default: return vex ? VDIVPD : DIVPD;
+    }
+}
+
+// reg = {lo, hi} in the low 128 bits, through reg
+static void emit_pair(const AsmOperand &lo, const AsmOperand &hi, const AsmOperand &reg, AsmCode &s) {
+    AsmOperand first = reg;
+    if (curr_vex && is_xmm(lo)) first = lo;
+    else emit_load(lo, reg, s);
+    if (curr_vex) emit_vex3(is_xmm(hi) ? VUNPCKLPD : VMOVHPD, hi, first, reg, s);
+    else if (is_xmm(hi)) emit_unpcklpd(hi, reg, s);
+    else emit_movhpd(hi, reg, s);
+}
+
+static void select_pack(const IrInstr &instr, const AsmOperand &d, AsmCode &s) {
+    vector<AsmOperand> lanes;
+    bool broadcast = true;
+    for (unsigned int k = 0; k < instr.args.size(); ++k) {
+        lanes.push_back(machine_operand(instr.args[k]));
+        if (!instr.args[k].same(instr.args[0])) broadcast = false;
+    }
+    AsmOperand dst = packed_operand(d);
+    AsmOperand xmm4 = asm_reg(XMM4);
+    if (curr_lanes > 2) {
+        if (broadcast) {
+            emit_vbroadcastsd(lanes[0], dst, s);
+            return;
+        }
+        AsmOperand xmm5 = asm_reg(XMM5);
+        emit_pair(lanes[0], lanes[1], xmm4, s);
+        emit_pair(lanes[2], lanes[3], xmm5, s);
+        emit_vinsertf128(xmm5, packed_operand(xmm4), dst, s);
         return;
-    } else if (deviation < 0) return;
-    res[0] = '-';
-    int digit = 0;
-    int tmp = deviation;
-    while (tmp != 0) {
-        ++digit;
-        tmp /= 10;
-    }
-    char digit_[digit + 1];
-    sprintf(digit_, "%d", deviation);
-    for (int i = 0; i < digit; i++) res[i + 1] = digit_[i];
-    res[digit + 1] = '\0';
-    res[digit + 1] = '(';
-    tmp = strlen(reg);
-    for (int i = 0; i < tmp; ++i) res[digit + 2 + i] = reg[i];
-    res[digit + strlen(reg) + 2] = ')';
-    res[digit + strlen(reg) + 3] = '\0';
-    return;
+    }
+    if (broadcast) {
+        emit_load(lanes[0], d, s);
+        emit_unpcklpd(dst, dst, s);
+        return;
+    }
+    // build it aside when the second lane is read from d
+    AsmOperand reg = same_operand(lanes[1], d) ? xmm4 : d;
+    emit_pair(lanes[0], lanes[1], reg, s);
+    if (!same_operand(reg, d)) emit_movapd(xmm4, dst, s);
+}
+
+static void select_packed_op(const IrInstr &instr, const AsmOperand &d, const AsmOperand &a,
+                             const AsmOperand &b, AsmCode &s) {
+    AsmOperand pa = packed_operand(a), pb = packed_operand(b), pd = packed_operand(d);
+    const char *op = packed_op(instr.op);
+    if (curr_lanes > 2) emit_vex3(op, pb, pa, pd, s);
+    else if (same_operand(d, a)) emit_instr(op, pb, pd, s);
+    else if (!same_operand(d, b)) {
+        emit_movapd(pa, pd, s);
+        emit_instr(op, pb, pd, s);
+    }
+    else if (instr.op == IR_VFADD || instr.op == IR_VFMUL) emit_instr(op, pa, pd, s);
+    else {
+        AsmOperand xmm4 = asm_reg(XMM4);
+        emit_movapd(pb, xmm4, s);
+        emit_movapd(pa, pd, s);
+        emit_instr(op, xmm4, pd, s);
+    }
+}
+
+static void select_lane(const IrInstr &instr, const AsmOperand &d, const AsmOperand &a, AsmCode &s) {
+    int lane = instr.b.imm;
+    AsmOperand reg = is_xmm(d) ? d : asm_reg(XMM4);
+    AsmOperand half = a;
+    if (lane >= 2) {
+        half = asm_reg(XMM4);
+        emit_vextractf128(packed_operand(a), half, s);
+    }
+    if (lane % 2 == 0) emit_load(half, reg, s);
+    else if (curr_vex) emit_vex3(VUNPCKHPD, half, half, reg, s);
+    else {
+        emit_movapd(half, reg, s);
+        emit_unpckhpd(reg, reg, s);
+    }
+    emit_load(reg, d, s);
+}
+
+static void select_instr(const IrInstr &instr, int next_block, AsmCode &s) {
+    AsmOperand d = machine_operand(instr.dst);
+    AsmOperand a = machine_operand(instr.a);
+    AsmOperand b = machine_operand(instr.b);
+    AsmOperand rax = asm_reg(RAX);
+    AsmOperand xmm5 = asm_reg(XMM5);
+    switch (instr.op) {
+        case IR_MOV:
+            emit_load(a, d, s);
+            break;
+        case IR_MUL:
+            if (select_mul_const(instr, d, s)) break;
+            // fall through
+        case IR_ADD:
+        case IR_SUB:
+        case IR_AND:
+        case IR_OR:
+        case IR_XOR: {
+            AsmOperand rhs = in_reg_unless(!is_wide_imm(b), b, RCX, s);
+            if (d.kind == ASM_REG && !same_operand(d, rhs)) {
+                emit_load(a, d, s);
+                emit_int_op(instr.op, rhs, d, s);
+            } else {
+                emit_load(a, rax, s);
+                emit_int_op(instr.op, rhs, rax, s);
+                emit_load(rax, d, s);
+            }
+            break;
+        }
+        case IR_DIV:
+        case IR_MOD: {
+            if (select_div_const(instr, d, s)) break;
+            AsmOperand rhs = in_reg_unless(!is_imm(b), b, RCX, s);
+            emit_load(a, rax, s);
+            emit_cqto(s);
+            emit_div(rhs, s);
+            emit_load(asm_reg(instr.op == IR_DIV ? RAX : RDX), d, s);
+            break;
+        }
+        case IR_FADD:
+        case IR_FSUB:
+        case IR_FMUL:
+        case IR_FDIV: {
+            AsmOperand rhs = in_reg_unless(!is_imm(b), b, XMM4, s);
+            if (is_xmm(d) && !same_operand(d, rhs)) {
+                emit_load(a, d, s);
+                emit_float_op(instr.op, rhs, d, s);
+            } else {
+                emit_load(a, xmm5, s);
+                emit_float_op(instr.op, rhs, xmm5, s);
+                emit_load(xmm5, d, s);
+            }
+            break;
+        }
+        case IR_NEG:
+        case IR_NOT: {
+            AsmOperand reg = d.kind == ASM_REG ? d : rax;
+            emit_load(a, reg, s);
+            if (instr.op == IR_NEG) emit_neg(reg, s);
+            else emit_not(reg, s);
+            emit_load(reg, d, s);
+            break;
+        }
+        case IR_FNEG:
+            // flip the sign bit
+            emit_load(a, rax, s);
+            emit_mov(asm_imm(LLONG_MIN), asm_reg(RDX), s);
+            emit_xor(asm_reg(RDX), rax, s);
+            emit_load(rax, d, s);
+            break;
+        case IR_I2F:
+            emit_load(a, rax, s);
+            if (is_xmm(d)) emit_int_to_float(rax, d, s);
+            else {
+                emit_int_to_float(rax, xmm5, s);
+                emit_load(xmm5, d, s);
+            }
+            break;
+        case IR_LT:
+        case IR_LE:
+        case IR_EQ:
+        case IR_NE:
+        case IR_GE:
+        case IR_GT:
+            select_compare(instr, d, s);
+            break;
+        case IR_CALL:
+            select_call(instr, d, s);
+            break;
+        case IR_TAILCALL:
+            // arguments on the stack need a frame to sit in
+            if (needs_stack_args(instr)) {
+                select_call(instr, asm_operand(ASM_NONE), s);
+                emit_epilogue(s);
+                break;
+            }
+            // the callee returns straight to our caller
+            emit_call_args(instr, s);
+            emit_leave_frame(s);
+            emit_jmp(asm_symbol(instr.callee), s);
+            break;
+        case IR_JMP:
+            if (instr.target != next_block) emit_jmp(block_label(instr.target), s);
+            break;
+        case IR_BR:
+            if (instr.a.kind == IR_IMM) {
+                int target = instr.a.imm ? instr.target : instr.target2;
+                if (target != next_block) emit_jmp(block_label(target), s);
+                break;
+            }
+            if (is_reg(a)) emit_test(a, a, s);
+            else emit_cmp(asm_imm(0), a, s);
+            if (instr.target == next_block) emit_jz(block_label(instr.target2), s);
+            else {
+                emit_jnz(block_label(instr.target), s);
+                if (instr.target2 != next_block) emit_jmp(block_label(instr.target2), s);
+            }
+            break;
+        case IR_RET:
+            // put the result into %rax
+            if (instr.a.kind != IR_NONE) emit_load(a, rax, s);
+            emit_epilogue(s);
+            break;
+        case IR_VPACK:
+            select_pack(instr, d, s);
+            break;
+        case IR_VFADD:
+        case IR_VFSUB:
+        case IR_VFMUL:
+        case IR_VFDIV:
+            select_packed_op(instr, d, a, b, s);
+            break;
+        case IR_VLANE:
+            select_lane(instr, d, a, s);
+            break;
+        case IR_VEND:
+            if (curr_lanes > 2) emit_vzeroupper(s);
+            break;
+    }
+}
+
+static void code_function(IrFunction &fn, ostream &s) {
+    IrAllocation alloc;
+    ir_allocate(fn, INT_POOL, FLOAT_POOL, disable_reg_alloc, alloc);
+    curr_alloc = &alloc;
+    curr_lanes = fn.lanes;
+    block_pos_base = pos_available;
+    pos_available += fn.blocks.size();
+
+    // Header part
+    s << GLOBAL << fn.name << endl <<
+      SYMBOL_TYPE << fn.name << ", " << FUNCTION << endl <<
+      fn.name << ':' << endl;
+
+    // lay out the frame: the callee-saved registers in use, then the slots
+    bool leaf = true;
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b)
+        for (unsigned int i = 0; i < fn.blocks[b].instrs.size(); ++i) {
+            const IrInstr &instr = fn.blocks[b].instrs[i];
+            if (instr.op == IR_CALL || (instr.op == IR_TAILCALL && needs_stack_args(instr))) leaf = false;
+        }
+    curr_int_regs = leaf ? LEAF_ALLOC_REGS : ALLOC_REGS;
+    vector<bool> reg_used(INT_POOL.num, false);
+    for (int v = 0; v < fn.vreg_count(); ++v)
+        if (alloc.loc[v].in_reg && !fn.vreg_is_float[v]) reg_used[alloc.loc[v].reg] = true;
+    curr_frame.has_fp = !leaf;
+    curr_frame.saved.clear();
+    for (int r = 0; r < INT_POOL.num; ++r)
+        if (reg_used[r] && is_callee_saved(curr_int_regs[r])) curr_frame.saved.push_back(curr_int_regs[r]);
+    int saved_size = 8 * curr_frame.saved.size();
+    int slots_size = 8 * alloc.slot_count;
+    if (leaf) curr_frame.reserved = slots_size > RED_ZONE ? slots_size : 0;
+    // keep %rsp 16-byte aligned at calls, as %rbp is
+    else curr_frame.reserved = (saved_size + slots_size + 15) / 16 * 16 - saved_size;
+
+    // the instructions, written out once the peephole pass has seen them
+    AsmCode code;
+
+    // save workspace first
+    if (curr_frame.has_fp) {
+        emit_push(asm_reg(RBP), code);
+        emit_mov(asm_reg(RSP), asm_reg(RBP), code);
+    }
+    for (unsigned int r = 0; r < curr_frame.saved.size(); ++r)
+        emit_push(asm_reg(curr_frame.saved[r]), code);
+    // reserve the whole frame at once
+    if (curr_frame.reserved > 0) emit_sub(asm_imm(curr_frame.reserved), asm_reg(RSP), code);
+
+    // move params to their locations; the ones the caller pushed sit
+    // above the return address
+    int int_num = 0;
+    int float_num = 0;
+    int stack_num = 0;
+    int args_base = curr_frame.has_fp ? 16 : curr_frame.reserved + saved_size + 8;
+    for (unsigned int i = 0; i < fn.params.size(); ++i) {
+        AsmOperand p = machine_operand(fn.params[i]);
+        if (fn.params[i].is_float && float_num < CALL_XMM_COUNT)
+            emit_load(asm_reg(CALL_XMM[float_num++]), p, code);
+        else if (!fn.params[i].is_float && int_num < CALL_REG_COUNT)
+            emit_load(asm_reg(CALL_REGS[int_num++]), p, code);
+        else emit_load(asm_mem(curr_frame.has_fp ? RBP : RSP, args_base + 8 * stack_num++), p, code);
+    }
+
+    // how often each vreg is read, to spot compares that only feed a branch
+    vector<int> use_count(fn.vreg_count(), 0);
+    vector<IrOperand> uses;
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b)
+        for (unsigned int i = 0; i < fn.blocks[b].instrs.size(); ++i) {
+            uses.clear();
+            ir_uses(fn.blocks[b].instrs[i], uses);
+            for (unsigned int u = 0; u < uses.size(); ++u)
+                if (uses[u].is_vreg()) ++use_count[uses[u].vreg];
+        }
+
+    // the caller-saved registers each call has a live value in
+    IrLiveness live;
+    ir_liveness(fn, live);
+    vector<vector<vector<const char *> > > call_saves(fn.blocks.size());
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b) {
+        const vector<IrInstr> &instrs = fn.blocks[b].instrs;
+        vector<bool> live_now = live.live_out[b];
+        call_saves[b].assign(instrs.size(), vector<const char *>());
+        for (int i = instrs.size() - 1; i >= 0; --i) {
+            if (instrs[i].has_dst()) live_now[instrs[i].dst.vreg] = false;
+            if (instrs[i].op == IR_CALL)
+                for (int v = 0; v < fn.vreg_count(); ++v) {
+                    if (!live_now[v] || !alloc.loc[v].in_reg) continue;
+                    const char *reg = fn.vreg_is_float[v] ? ALLOC_XMM[alloc.loc[v].reg] : curr_int_regs[alloc.loc[v].reg];
+                    if (!is_callee_saved(reg)) call_saves[b][i].push_back(reg);
+                }
+            uses.clear();
+            ir_uses(instrs[i], uses);
+            for (unsigned int u = 0; u < uses.size(); ++u)
+                if (uses[u].is_vreg()) live_now[uses[u].vreg] = true;
+        }
+    }
+
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b) {
+        const IrBlock &block = fn.blocks[b];
+        emit_position(block_label(b), code);
+        curr_vex = false;
+        for (unsigned int i = 0; i < block.instrs.size(); ++i)
+            if (curr_lanes > 2 && block.instrs[i].is_vector()) curr_vex = true;
+        for (unsigned int i = 0; i < block.instrs.size(); ++i) {
+            const IrInstr &instr = block.instrs[i];
+            curr_call_saves = call_saves[b][i];
+            bool is_compare = instr.op >= IR_LT && instr.op <= IR_GT;
+            if (is_compare && i + 1 < block.instrs.size()) {
+                const IrInstr &br = block.instrs[i + 1];
+                if (br.op == IR_BR && br.a.is_vreg() && br.a.vreg == instr.dst.vreg &&
+                    use_count[instr.dst.vreg] == 1) {
+                    select_compare_branch(instr, br, b + 1, code);
+                    ++i;
+                    continue;
+                }
+            }
+            select_instr(instr, b + 1, code);
+        }
+    }
+
+    if (cgen_optimize) peephole_optimize(code);
+    asm_write(code, s);
+
+    // after return
+    s << SIZE << fn.name << COMMA << ".-" << fn.name << endl;
+    curr_alloc = NULL;
+    curr_vex = false;
 }
 
 void code_global_data(Decls decls, ostream &str) {
@@ -465,18 +1636,9 @@ void code_global_data(Decls decls, ostream &str) {
             } else if (sameType(type_tmp, Bool)) {
                 emit_global_bool(variableDecl->getName(), str);
             }
-            // add to scope
+            // add to scope, globals stay in memory
             varNameToAddr.addid(variableDecl->getName(), new int(name_proc.size()));
-            int len = strlen(variableDecl->getName()->get_string()) + 7;
-            name_proc.push_back(new char[len]);
-            strcpy(name_proc[name_proc.size() - 1], variableDecl->getName()->get_string());
-            name_proc[name_proc.size() - 1][strlen(variableDecl->getName()->get_string()) + 6] = '\0';
-            name_proc[name_proc.size() - 1][strlen(variableDecl->getName()->get_string()) + 5] = ')';
-            name_proc[name_proc.size() - 1][strlen(variableDecl->getName()->get_string()) + 4] = 'p';
-            name_proc[name_proc.size() - 1][strlen(variableDecl->getName()->get_string()) + 3] = 'i';
-            name_proc[name_proc.size() - 1][strlen(variableDecl->getName()->get_string()) + 2] = 'r';
-            name_proc[name_proc.size() - 1][strlen(variableDecl->getName()->get_string()) + 1] = '%';
-            name_proc[name_proc.size() - 1][strlen(variableDecl->getName()->get_string())] = '(';
+            name_proc.push_back(ir_global(variableDecl->getName()->get_string(), sameType(type_tmp, Float)));
             //            variableDecl->code(str); Note that this function is for temporary variableDecls in callDecl.
         }
     }
@@ -495,6 +1657,19 @@ void code_calls(Decls decls, ostream &str) {
             call->code(str);
         }
     }
+    // the whole program is lowered: calls can see their callees now
+    if (cgen_optimize) ir_inline(ir_program, cgen_inline_threshold);
+    for (unsigned int f = 0; f < ir_program.size(); ++f) {
+        IrFunction &fn = ir_program[f];
+        ir_tail_calls(fn);
+        ir_remove_unreachable(fn);
+        if (cgen_optimize) ir_optimize(fn);
+        // packed values only ever live in registers
+        if (cgen_optimize && !disable_reg_alloc) ir_vectorize(fn, cgen_vector_lanes);
+        if (cgen_optimize) ir_unroll(fn, cgen_unroll_factor);
+        if (cgen_dump_ir) ir_dump(fn, cout);
+        code_function(fn, str);
+    }
 }
 
 //***************************************************
@@ -519,14 +1694,16 @@ void cgen_helper(Decls decls, ostream &s) {
 
 
 void code(Decls decls, ostream &s) {
-    cgen_debug = 0;
     varNameToAddr.enterscope();
     if (cgen_debug) cout << "Coding global data\n";
     code_global_data(decls, s);
 
     if (cgen_debug) cout << "Coding calls\n";
     code_calls(decls, s);
+    // the float constants the functions used
+    floattable.code_string_table(s);
     varNameToAddr.exitscope();
+    if (cgen_optimize && cgen_debug) peephole_report(cout);
 }
 
 //******************************************************************
@@ -547,50 +1724,31 @@ void CallDecl_class::code(ostream &s) {
     if (cgen_debug) cout << "--- CallDecl_class::code :: name " << name->get_string() << " ---\n";
     varNameToAddr.enterscope();
 
-    // Header part
-    s << GLOBAL << name << endl <<
-      SYMBOL_TYPE << name << ", " << FUNCTION << endl <<
-      name << ':' << endl;
-
-    // save workspace first
-    //TODO:caller to protect R10, R11
-    emit_push(RBP, s);
-    emit_mov(RSP, RBP, s);
-    emit_push(RBX, s);
-    emit_push(R12, s);
-    emit_push(R13, s);
-    emit_push(R14, s);
-    emit_push(R15, s);
-    if (name->get_string() == Main->get_string()) curr_usage = 0;
-    else curr_usage = 40;
-
+    IrFunction fn;
+    fn.name = name->get_string();
+    fn.is_main = sameType(name, Main);
+    curr_fn = &fn;
+    curr_block = fn.new_block();
 
+    // params become virtual registers
     Variables params = getVariables();
-    int int_num = 0;
-    int float_num = 0;
     for (int i = params->first(); params->more(i); i = params->next(i)) {
-        // new stack piece
-        emit_sub("$8", RSP, s);
-        // move param to sub stack
-        curr_usage += 8;
-        int len = count_len_addr_reg_shift(RBP, curr_usage);
-        char reg[len];
-        addr_reg_shift(reg, RBP, curr_usage);
-        if (sameType(params->nth(i)->getType(), Float)) emit_movsd(CALL_XMM[float_num++], reg, s);
-        else emit_mov(CALL_REGS[int_num++], reg, s);
+        IrOperand param = new_value(sameType(params->nth(i)->getType(), Float));
+        fn.params.push_back(param);
         // add to scope
         varNameToAddr.addid(params->nth(i)->getName(), new int(name_proc.size()));
-        char *c = new char[len];
-        strcpy(c, reg);
-        name_proc.push_back(c);
+        name_proc.push_back(param);
     }
-    // check body TODO
     getBody()->code(s);
-
-    // after return
-    s << SIZE << name << COMMA << ".-" << name << endl;
+    // falling off the end returns
+    if (!block_closed()) ir_emit(ir_ret(ir_none()));
 
     varNameToAddr.exitscope();
+    curr_fn = NULL;
+
+    ir_build_cfg(fn);
+    ir_program.push_back(fn);
+
     if (cgen_debug) cout << "--- CallDecl_class::code :: name " << name->get_string() << " ---\n";
 }
 
@@ -606,24 +1764,19 @@ void StmtBlock_class::code(ostream &s) {
 
     VariableDecls localVarDecls = getVariableDecls();
     for (int i = localVarDecls->first(); localVarDecls->more(i); i = localVarDecls->next(i)) {
-        // new stack piece
-        emit_sub("$8", RSP, s);
-        // move param to sub stack
-        curr_usage += 8;
-        int len = count_len_addr_reg_shift(RBP, curr_usage);
-        char reg[len];
-        addr_reg_shift(reg, RBP, curr_usage);
+        // a new virtual register
+        IrOperand local = new_value(sameType(localVarDecls->nth(i)->getType(), Float));
         // add to scope
         varNameToAddr.addid(localVarDecls->nth(i)->getName(), new int(name_proc.size()));
-        char *c = new char[len];
-        strcpy(c, reg);
-        name_proc.push_back(c);
+        name_proc.push_back(local);
     }
     Stmts localStmts = getStmts();
     Stmt localStmt;
     for (int i = localStmts->first(); localStmts->more(i); i = localStmts->next(i)) {
         localStmt = localStmts->nth(i);
+        unsigned int depth = operandStack.size();
         localStmt->code(s);
+        discard_operands(depth);
     }
 
     varNameToAddr.exitscope();
@@ -639,45 +1792,21 @@ void IfStmt_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- IfStmt_class::code " << " ---\n";
 
-    // get 2 POS name
-    int pos_usable = pos_available; // pos_usable: else, pos_usable+1: basic basic after ifstmt
-    pos_available += 2;
-    getCondition()->code(s);
-    const char *c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RAX, s);
-    delete c;
-    emit_test(RAX, RAX, s);
-    int tmp = pos_usable;
-    int digit = 0;
-    if (tmp == 0) digit = 1;
-    else
-        while (tmp != 0) {
-            ++digit;
-            tmp /= 10;
-        }
-    char *pos_char = new char[digit + 6];
-    sprintf(pos_char, "%s%d", POSITION, pos_usable);
-    emit_jz(pos_char, s);
+    // get 3 blocks: then, else, basic block after ifstmt
+    int then_block = curr_fn->new_block();
+    int else_block = curr_fn->new_block();
+    int next_block = curr_fn->new_block();
+    code_condition(getCondition(), then_block, else_block, s);
+
+    curr_block = then_block;
     getThen()->code(s);
-    tmp = pos_usable + 1;
-    digit = 0;
-    if (tmp == 0) digit = 1;
-    else
-        while (tmp != 0) {
-            ++digit;
-            tmp /= 10;
-        }
-    char *pos_char1 = new char[digit + 6];
-    sprintf(pos_char1, "%s%d", POSITION, pos_usable + 1);
-    emit_jmp(pos_char1, s);
+    close_block(next_block);
 
-    emit_position(pos_char, s);
+    curr_block = else_block;
     getElse()->code(s);
+    close_block(next_block);
 
-    emit_position(pos_char1, s);
-    delete[]pos_char;
-    delete[]pos_char1;
+    curr_block = next_block;
 
     if (cgen_debug) cout << "--- IfStmt_class::code " << " ---\n";
 }
@@ -691,54 +1820,24 @@ void WhileStmt_class::code(ostream &s) {
 
     if (cgen_debug) cout << "--- WhileStmt_class::code " << " ---\n";
 
-    // get 2 POS name
-    int pos_usable = pos_available; // pos_usable: body; pos_usable+1: outside while
-    pos_available += 2;
-    int tmp = pos_usable;
-    int digit = 0;
-    if (tmp == 0) digit = 1;
-    else
-        while (tmp != 0) {
-            ++digit;
-            tmp /= 10;
-        }
-    char *pos_char = new char[digit + 6];
-    sprintf(pos_char, "%s%d", POSITION, pos_usable);
-    tmp = pos_usable + 1;
-    digit = 0;
-    if (tmp == 0) digit = 1;
-    else
-        while (tmp != 0) {
-            ++digit;
-            tmp /= 10;
-        }
-    char *pos_char1 = new char[digit + 6];
-    sprintf(pos_char1, "%s%d", POSITION, pos_usable + 1);
-
-    // add while message to LOOP_MSG
-    char * msg1 = new char[strlen(pos_char)];
-    strcpy(msg1, pos_char);
-    char * msg2 = new char[strlen(pos_char1)];
-    strcpy(msg2, pos_char1);
-    LOOP *msg = new LOOP(msg1, msg2);
-    LOOP_MSG.push(msg);
+    // get 3 blocks: check, body, outside while
+    int check_block = curr_fn->new_block();
+    int body_block = curr_fn->new_block();
+    int next_block = curr_fn->new_block();
+    close_block(check_block);
 
     // loop: check -> run -> back
-    emit_position(pos_char, s);
-    condition->code(s);
-    const char *c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RAX, s);
-    emit_test(RAX, RAX, s);
-    emit_jz(pos_char1, s);
+    curr_block = check_block;
+    code_condition(condition, body_block, next_block, s);
+
+    curr_block = body_block;
+    LOOP_MSG.push(LOOP(check_block, next_block));
     body->code(s);
-    emit_jmp(pos_char, s);
+    LOOP_MSG.pop();
+    close_block(check_block);
 
     // next stmt
-    emit_position(pos_char1, s);
-
-    delete []pos_char;
-    delete []pos_char1;
+    curr_block = next_block;
 
     if (cgen_debug) cout << "--- WhileStmt_class::code " << " ---\n";
 }
@@ -754,68 +1853,33 @@ void ForStmt_class::code(ostream &s) {
 
     if (cgen_debug) cout << "--- ForStmt_class::code " << " ---\n";
 
+    unsigned int depth = operandStack.size();
     initexpr->code(s);
+    discard_operands(depth);
 
-    // get 3 POS name
-    int pos_usable = pos_available; // pos_usable: condition; pos_usable+1: loopact; pos_usable+2: outside for
-    pos_available += 3;
-    int tmp = pos_usable;
-    int digit = 0;
-    if (tmp == 0) digit = 1;
-    else
-        while (tmp != 0) {
-            ++digit;
-            tmp /= 10;
-        }
-    char *pos_char = new char[digit + 6];
-    sprintf(pos_char, "%s%d", POSITION, pos_usable);
-    tmp = pos_usable + 1;
-    digit = 0;
-    if (tmp == 0) digit = 1;
-    else
-        while (tmp != 0) {
-            ++digit;
-            tmp /= 10;
-        }
-    char *pos_char1 = new char[digit + 6];
-    sprintf(pos_char1, "%s%d", POSITION, pos_usable + 1);
-    tmp = pos_usable + 1;
-    digit = 0;
-    if (tmp == 0) digit = 1;
-    else
-        while (tmp != 0) {
-            ++digit;
-            tmp /= 10;
-        }
-    char *pos_char2 = new char[digit + 6];
-    sprintf(pos_char2, "%s%d", POSITION, pos_usable + 2);
-
-    // add while message to LOOP_MSG
-    char * msg1 = new char[strlen(pos_char)];
-    strcpy(msg1, pos_char);
-    char * msg2 = new char[strlen(pos_char2)];
-    strcpy(msg2, pos_char1);
-    LOOP *msg = new LOOP(msg1, msg2);
-    LOOP_MSG.push(msg);
-
-    emit_position(pos_char, s);
-    condition->code(s);
-    const char *c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RAX, s);
-    emit_test(RAX, RAX, s);
-    emit_jz(pos_char2, s);
+    // get 4 blocks: condition, body, loopact, outside for
+    int check_block = curr_fn->new_block();
+    int body_block = curr_fn->new_block();
+    int loop_block = curr_fn->new_block();
+    int next_block = curr_fn->new_block();
+    close_block(check_block);
+
+    curr_block = check_block;
+    // an empty condition loops forever
+    code_condition(condition, body_block, next_block, s);
+
+    curr_block = body_block;
+    LOOP_MSG.push(LOOP(loop_block, next_block));
     body->code(s);
+    LOOP_MSG.pop();
+    close_block(loop_block);
 
-    emit_position(pos_char1, s);
+    curr_block = loop_block;
     loopact->code(s);
-    emit_jmp(pos_char, s);
-
-    emit_position(pos_char2, s);
+    discard_operands(depth);
+    close_block(check_block);
 
-    delete []pos_char;
-    delete []pos_char1;
-    delete []pos_char2;
+    curr_block = next_block;
 
     if (cgen_debug) cout << "--- ForStmt_class::code " << " ---\n";
 }
@@ -827,31 +1891,10 @@ void ReturnStmt_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- ReturnStmt_class::code ---\n";
 
-    // clear LOOP_MSG first
-//    while (!LOOP_MSG.empty()) {
-//        LOOP *l = LOOP_MSG.top();
-//        LOOP_MSG.pop();
-//        delete l;
-//    }
-
-    // put the result into %rax
     value->code(s);
-    const char *c = operandStack.top();
-    if (c != nullptr) {
-        operandStack.pop();
-        emit_mov(c, RAX, s);
-        delete c;
-    }
-
-    // restore previous workspace
-    emit_pop(R15, s);
-    emit_pop(R14, s);
-    emit_pop(R13, s);
-    emit_pop(R12, s);
-    emit_pop(RBX, s);
-    // go back
-    emit_leave(s);
-    emit_ret(s);
+    IrOperand c = pop_operand();
+    ir_emit(ir_ret(c));
+    start_unreachable_block();
 
     if (cgen_debug) cout << "--- ReturnStmt_class::code ---\n";
 }
@@ -863,10 +1906,8 @@ void ContinueStmt_class::code(ostream &s) {
 
     if (cgen_debug) cout << "--- ContinueStmt_class::code ---\n";
 
-    LOOP *msg = LOOP_MSG.top();
-//    LOOP_MSG.pop();
-    emit_jmp(msg->back, s);
-//    delete msg;
+    ir_emit(ir_jmp(LOOP_MSG.top().back));
+    start_unreachable_block();
 
     if (cgen_debug) cout << "--- ContinueStmt_class::code ---\n";
 }
@@ -878,10 +1919,8 @@ void BreakStmt_class::code(ostream &s) {
 
     if (cgen_debug) cout << "--- BreakStmt_class::code ---\n";
 
-    LOOP *msg = LOOP_MSG.top();
-//    LOOP_MSG.pop();
-    emit_jmp(msg->next, s);
-//    delete msg;
+    ir_emit(ir_jmp(LOOP_MSG.top().next));
+    start_unreachable_block();
 
     if (cgen_debug) cout << "--- BreakStmt_class::code ---\n";
 }
@@ -893,116 +1932,19 @@ void Call_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Call_class::code ---\n";
 
-    if (strcmp(name->get_string(), print->get_string())==0) {
-        int int_num_tmp = 0;
-        int float_num_tmp = 0;
-        int float_num = 0;
-        for (int i = actuals->first(); actuals->more(i); i = actuals->next(i)) {
-            actuals->nth(i)->code(s);
-            if (sameType(actuals->nth(i)->getType(), Float)) ++float_num;
-        }
-        stack<char const *> stk;
-        for (int i = actuals->first(); actuals->more(i); i = actuals->next(i)) {
-            const char *a = operandStack.top();
-            operandStack.pop();
-            stk.push(a);
-        }
-        for (int i = actuals->first(); actuals->more(i); i = actuals->next(i)) {
-            const char *a = stk.top();
-            stk.pop();
-            if (sameType(actuals->nth(i)->getType(), Float)) {
-                emit_movsd(a, CALL_XMM[float_num_tmp++], s);
-            }
-            else emit_mov(a, CALL_REGS[int_num_tmp++], s);
-            delete [] a;
-        }
-        // get stack space ready for the result
-        emit_sub("$8", RSP, s);
-        curr_usage += 8;
-        int res_addr = curr_usage;
-        int tmp = float_num;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char ctmp[digit];
-        sprintf(ctmp, "%d", float_num);
-        emit_irmovl(ctmp, EAX, s);
-        // store the workspace (caller reg)
-        emit_push(R10, s);
-        emit_push(R11, s);
-        curr_usage += 16;
-        // call
-        emit_call(name->get_string(), s);
-        // restore workspace
-        emit_pop(R11, s);
-        emit_pop(R10, s);
-        curr_usage -= 16;
+    for (int i = actuals->first(); actuals->more(i); i = actuals->next(i)) {
+        actuals->nth(i)->code(s);
     }
-    else {
-        int int_num_tmp = 0;
-        int float_num_tmp = 0;
-        for (int i = actuals->first(); actuals->more(i); i = actuals->next(i)) {
-            actuals->nth(i)->code(s);
-        }
-        stack<char const *> stk;
-        for (int i = actuals->first(); actuals->more(i); i = actuals->next(i)) {
-            const char *a = operandStack.top();
-            operandStack.pop();
-            stk.push(a);
-        }
-        for (int i = actuals->first(); actuals->more(i); i = actuals->next(i)) {
-            const char *a = stk.top();
-            stk.pop();
-            if (sameType(actuals->nth(i)->getType(), Float)) emit_movsd(a, CALL_XMM[float_num_tmp++], s);
-            else emit_mov(a, CALL_REGS[int_num_tmp++], s);
-            delete [] a;
-        }
-        // store the workspace (caller reg)
-        emit_push(R10, s);
-        emit_push(R11, s);
-        curr_usage += 16;
-        // call
-        emit_call(name->get_string(), s);
-        // restore workspace
-        emit_pop(R11, s);
-        emit_pop(R10, s);
-        curr_usage -= 16;
-        if (!sameType(getType(), Void)) {
-            // get stack space ready for the result
-            emit_sub("$8", RSP, s);
-            curr_usage += 8;
-            int res_addr = curr_usage;
-            int len = count_len_addr_reg_shift(RBP, res_addr);
-            char reg[len];
-            addr_reg_shift(reg, RBP, res_addr);
-            // get the result
-            emit_mov(RAX, reg, s);
-            char *c = new char[len];
-            strcpy(c, reg);
-            operandStack.push(c);
-        }
-    }
-
-    if (cgen_debug) cout << "--- Call_class::code ---\n";
-
-    //
-    /*
-     if function name is printf
+    vector<IrOperand> args;
+    for (int i = actuals->first(); actuals->more(i); i = actuals->next(i)) args.push_back(pop_operand());
+    reverse(args.begin(), args.end());
 
-      // please set %eax to the number of Float parameters, num.
-      //  把%eax赋值为Float类型的参数个数, num
-      emit_sub("$8", RSP, s);
-      emit_irmovl(num, EAX, s);
-      emit_call("printf", s);
+    IrOperand res = ir_none();
+    if (!sameType(getType(), Void)) res = new_value(sameType(getType(), Float));
+    ir_emit(ir_call(res, name->get_string(), args));
+    operandStack.push(res);
 
-      return;
-    }
-    */
-    //
+    if (cgen_debug) cout << "--- Call_class::code ---\n";
 }
 
 void Actual_class::code(ostream &s) {
@@ -1024,21 +1966,15 @@ void Assign_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Assign_class::code ---\n";
 
-    // TODO: unable to assign to global string var! no definition
     value->code(s);
-    // assign value value_addr -> RAX -> lvalue_addr with the help of varNameToAddr
-    const char *c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RAX, s);
-    delete c;
-    int *idx = varNameToAddr.lookup(lvalue);
-    const char *addr = name_proc[*idx];
-    emit_mov(RAX, addr, s);
+    IrOperand c = pop_operand();
+    // assign the value with the help of varNameToAddr
+    IrOperand var = name_proc[*varNameToAddr.lookup(lvalue)];
+    if (var.is_float) c = as_float(c);
+    ir_emit(ir_mov(var, c));
 
     // put result into the operandStack
-    char *str = new char[strlen(addr)];
-    strcpy(str, addr);
-    operandStack.push(str);
+    operandStack.push(var.is_vreg() ? var : c);
 
     if (cgen_debug) cout << "--- Assign_class::code ---\n";
 }
@@ -1051,105 +1987,7 @@ void Add_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Add_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    e2->code(s);
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    // case: both Int
-    if (sameType(e1->getType(), Int) && sameType(e2->getType(), Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, R12, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RBX, s);
-        delete c;
-        emit_add(RBX, R12, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(R12, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: both Float
-    else if (sameType(e1->getType(), Float) && sameType(e2->getType(), Float)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM5, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM4, s);
-        delete c;
-        emit_addsd(XMM4, XMM5, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_movsd(XMM5, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Int, Float
-    else if (sameType(e1->getType(), Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM5, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RBX, s);
-        emit_int_to_float(RBX, XMM4, s);
-        delete c;
-        emit_addsd(XMM4, XMM5, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_movsd(XMM5, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Float, Int
-    else {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RBX, s);
-        emit_int_to_float(RBX, XMM5, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM4, s);
-        delete c;
-        emit_addsd(XMM4, XMM5, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_movsd(XMM5, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
+    code_arith(e1, e2, IR_ADD, IR_FADD, s);
 
     if (cgen_debug) cout << "--- Add_class::code ---\n";
 }
@@ -1162,105 +2000,7 @@ void Minus_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Minus_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    e2->code(s);
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    // case: both Int
-    if (sameType(e1->getType(), Int) && sameType(e2->getType(), Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, R12, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RBX, s);
-        delete c;
-        emit_sub(R12, RBX, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RBX, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: both Float
-    else if (sameType(e1->getType(), Float) && sameType(e2->getType(), Float)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM5, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM4, s);
-        delete c;
-        emit_subsd(XMM4, XMM5, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_movsd(XMM5, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Int, Float
-    else if (sameType(e1->getType(), Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM5, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RBX, s);
-        emit_int_to_float(RBX, XMM4, s);
-        delete c;
-        emit_subsd(XMM4, XMM5, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_movsd(XMM5, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Float, Int
-    else {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RBX, s);
-        emit_int_to_float(RBX, XMM5, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM4, s);
-        delete c;
-        emit_subsd(XMM5, XMM4, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_movsd(XMM4, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
+    code_arith(e1, e2, IR_SUB, IR_FSUB, s);
 
     if (cgen_debug) cout << "--- Minus_class::code ---\n";
 }
@@ -1273,105 +2013,7 @@ void Multi_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Multi_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    e2->code(s);
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    // case: both Int
-    if (sameType(e1->getType(), Int) && sameType(e2->getType(), Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, R12, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RBX, s);
-        delete c;
-        emit_mul(R12, RBX, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RBX, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: both Float
-    else if (sameType(e1->getType(), Float) && sameType(e2->getType(), Float)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM5, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM4, s);
-        delete c;
-        emit_mulsd(XMM5, XMM4, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_movsd(XMM4, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Int, Float
-    else if (sameType(e1->getType(), Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM5, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RBX, s);
-        emit_int_to_float(RBX, XMM4, s);
-        delete c;
-        emit_mulsd(XMM5, XMM4, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_movsd(XMM4, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Float, Int
-    else {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RBX, s);
-        emit_int_to_float(RBX, XMM5, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM4, s);
-        delete c;
-        emit_mulsd(XMM5, XMM4, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_movsd(XMM4, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
+    code_arith(e1, e2, IR_MUL, IR_FMUL, s);
 
     if (cgen_debug) cout << "--- Multi_class::code ---\n";
 }
@@ -1384,106 +2026,7 @@ void Divide_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Divide_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    e2->code(s);
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    // case: both Int
-    if (sameType(e1->getType(), Int) && sameType(e2->getType(), Int)) {
-        const char *c1 = operandStack.top();
-        operandStack.pop();
-        const char *c2 = operandStack.top();
-        operandStack.pop();
-        emit_mov(c2, RAX, s);
-        emit_cqto(s);
-        emit_mov(c1, RBX, s);
-        delete c1;
-        delete c2;
-        emit_div(RBX, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: both Float
-    else if (sameType(e1->getType(), Float) && sameType(e2->getType(), Float)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM5, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM4, s);
-        delete c;
-        emit_divsd(XMM5, XMM4, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_movsd(XMM4, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Int, Float
-    else if (sameType(e1->getType(), Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM5, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RBX, s);
-        emit_int_to_float(RBX, XMM4, s);
-        delete c;
-        emit_divsd(XMM5, XMM4, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_movsd(XMM4, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Float, Int
-    else {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RBX, s);
-        emit_int_to_float(RBX, XMM5, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM4, s);
-        delete c;
-        emit_divsd(XMM5, XMM4, s);
-        // store result
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_movsd(XMM4, reg, s);
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
+    code_arith(e1, e2, IR_DIV, IR_FDIV, s);
 
     if (cgen_debug) cout << "--- Divide_class::code ---\n";
 }
@@ -1496,35 +2039,7 @@ void Mod_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Mod_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    e2->code(s);
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    const char *c1 = operandStack.top();
-    operandStack.pop();
-    const char *c2 = operandStack.top();
-    operandStack.pop();
-    emit_mov(c2, RAX, s);
-    emit_cqto(s);
-    emit_mov(c1, RBX, s);
-    delete c1;
-    delete c2;
-    emit_div(RBX, s);
-    // store result
-    int len = count_len_addr_reg_shift(RBP, res_addr);
-    char reg[len];
-    addr_reg_shift(reg, RBP, res_addr);
-    emit_mov(RDX, reg, s);
-
-    // put result into the operandStack
-    char *str = new char[len];
-    strcpy(str, reg);
-    operandStack.push(str);
+    code_logic(e1, e2, IR_MOD, s);
 
     if (cgen_debug) cout << "--- Mod_class::code ---\n";
 }
@@ -1534,26 +2049,15 @@ void Neg_class::code(ostream &s) {
         e1->code(s);
         return;
     }
+    if (cgen_debug) cout << "--- Neg_class::code ---\n";
 
     e1->code(s);
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    const char *c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RAX, s);
-    emit_neg(RAX, s);
-    // store result
-    int len = count_len_addr_reg_shift(RBP, res_addr);
-    char reg[len];
-    addr_reg_shift(reg, RBP, res_addr);
-    emit_mov(RAX, reg, s);
+    IrOperand c = pop_operand();
+    IrOperand res = new_value(c.is_float);
+    ir_emit(ir_unary(c.is_float ? IR_FNEG : IR_NEG, res, c));
+    operandStack.push(res);
 
-    // put result into the operandStack
-    char *str = new char[len];
-    strcpy(str, reg);
-    operandStack.push(str);
+    if (cgen_debug) cout << "--- Neg_class::code ---\n";
 }
 
 void Lt_class::code(ostream &s) {
@@ -1564,209 +2068,7 @@ void Lt_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Lt_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    Symbol type1 = e1->getType();
-    e2->code(s);
-    Symbol type2 = e2->getType();
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    // case: both Int
-    if (sameType(type1, Int) && sameType(type2, Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RDX, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RAX, s);
-        delete c;
-        emit_cmp(RDX, RAX, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jl(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: both Float
-    else if (sameType(type1, Float) && sameType(type2, Float)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, XMM0, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, XMM1, s);
-        delete c;
-        emit_ucompisd(XMM0, XMM1, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jb(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Int Float
-    else if (sameType(type1, Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM1, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        // convert Int to Float
-        emit_mov(c, RAX, s);
-        emit_int_to_float(RAX, XMM0, s);
-        delete c;
-        emit_ucompisd(XMM1, XMM0, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jb(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Float, Int
-    else {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        // convert Int to Float
-        emit_mov(c, RAX, s);
-        emit_int_to_float(RAX, XMM0, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM1, s);
-        emit_ucompisd(XMM0, XMM1, s);
-        delete c;
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jb(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
+    code_compare(e1, e2, IR_LT, s);
 
     if (cgen_debug) cout << "--- Lt_class::code ---\n";
 }
@@ -1779,209 +2081,7 @@ void Le_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Le_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    Symbol type1 = e1->getType();
-    e2->code(s);
-    Symbol type2 = e2->getType();
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    // case: both Int
-    if (sameType(type1, Int) && sameType(type2, Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RDX, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RAX, s);
-        delete c;
-        emit_cmp(RDX, RAX, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jle(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: both Float
-    else if (sameType(type1, Float) && sameType(type2, Float)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, XMM0, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, XMM1, s);
-        delete c;
-        emit_ucompisd(XMM0, XMM1, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jbe(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Int Float
-    else if (sameType(type1, Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM1, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        // convert Int to Float
-        emit_mov(c, RAX, s);
-        emit_int_to_float(RAX, XMM0, s);
-        delete c;
-        emit_ucompisd(XMM1, XMM0, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jbe(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Float, Int
-    else {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        // convert Int to Float
-        emit_mov(c, RAX, s);
-        emit_int_to_float(RAX, XMM0, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM1, s);
-        emit_ucompisd(XMM0, XMM1, s);
-        delete c;
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jbe(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
+    code_compare(e1, e2, IR_LE, s);
 
     if (cgen_debug) cout << "--- Le_class::code ---\n";
 }
@@ -1992,211 +2092,9 @@ void Equ_class::code(ostream &s) {
         e2->code(s);
         return;
     }
-    if (cgen_debug) cout << "--- Eqe_class::code ---\n";
+    if (cgen_debug) cout << "--- Equ_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    Symbol type1 = e1->getType();
-    e2->code(s);
-    Symbol type2 = e2->getType();
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    // case: both Int
-    if (sameType(type1, Int) && sameType(type2, Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RDX, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RAX, s);
-        delete c;
-        emit_cmp(RDX, RAX, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_je(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: both Float
-    else if (sameType(type1, Float) && sameType(type2, Float)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, XMM0, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, XMM1, s);
-        delete c;
-        emit_ucompisd(XMM0, XMM1, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_je(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Int Float
-    else if (sameType(type1, Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM1, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        // convert Int to Float
-        emit_mov(c, RAX, s);
-        emit_int_to_float(RAX, XMM0, s);
-        delete c;
-        emit_ucompisd(XMM1, XMM0, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_je(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Float, Int
-    else {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        // convert Int to Float
-        emit_mov(c, RAX, s);
-        emit_int_to_float(RAX, XMM0, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM1, s);
-        emit_ucompisd(XMM0, XMM1, s);
-        delete c;
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_je(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
+    code_compare(e1, e2, IR_EQ, s);
 
     if (cgen_debug) cout << "--- Equ_class::code ---\n";
 }
@@ -2209,209 +2107,7 @@ void Neq_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Neq_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    Symbol type1 = e1->getType();
-    e2->code(s);
-    Symbol type2 = e2->getType();
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    // case: both Int
-    if (sameType(type1, Int) && sameType(type2, Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RDX, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RAX, s);
-        delete c;
-        emit_cmp(RDX, RAX, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jne(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: both Float
-    else if (sameType(type1, Float) && sameType(type2, Float)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, XMM0, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, XMM1, s);
-        delete c;
-        emit_ucompisd(XMM0, XMM1, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jne(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Int Float
-    else if (sameType(type1, Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM1, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        // convert Int to Float
-        emit_mov(c, RAX, s);
-        emit_int_to_float(RAX, XMM0, s);
-        delete c;
-        emit_ucompisd(XMM1, XMM0, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jne(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Float, Int
-    else {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        // convert Int to Float
-        emit_mov(c, RAX, s);
-        emit_int_to_float(RAX, XMM0, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM1, s);
-        emit_ucompisd(XMM0, XMM1, s);
-        delete c;
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jne(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
+    code_compare(e1, e2, IR_NE, s);
 
     if (cgen_debug) cout << "--- Neq_class::code ---\n";
 }
@@ -2424,209 +2120,7 @@ void Ge_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Ge_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    Symbol type1 = e1->getType();
-    e2->code(s);
-    Symbol type2 = e2->getType();
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    // case: both Int
-    if (sameType(type1, Int) && sameType(type2, Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RDX, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RAX, s);
-        delete c;
-        emit_cmp(RDX, RAX, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jge(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: both Float
-    else if (sameType(type1, Float) && sameType(type2, Float)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, XMM0, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, XMM1, s);
-        delete c;
-        emit_ucompisd(XMM0, XMM1, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jae(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Int Float
-    else if (sameType(type1, Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM1, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        // convert Int to Float
-        emit_mov(c, RAX, s);
-        emit_int_to_float(RAX, XMM0, s);
-        delete c;
-        emit_ucompisd(XMM1, XMM0, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jae(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Float, Int
-    else {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        // convert Int to Float
-        emit_mov(c, RAX, s);
-        emit_int_to_float(RAX, XMM0, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM1, s);
-        emit_ucompisd(XMM0, XMM1, s);
-        delete c;
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jae(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
+    code_compare(e1, e2, IR_GE, s);
 
     if (cgen_debug) cout << "--- Ge_class::code ---\n";
 }
@@ -2639,209 +2133,7 @@ void Gt_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Gt_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    Symbol type1 = e1->getType();
-    e2->code(s);
-    Symbol type2 = e2->getType();
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    // case: both Int
-    if (sameType(type1, Int) && sameType(type2, Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RDX, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, RAX, s);
-        delete c;
-        emit_cmp(RDX, RAX, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_jg(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: both Float
-    else if (sameType(type1, Float) && sameType(type2, Float)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, XMM0, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_mov(c, XMM1, s);
-        delete c;
-        emit_ucompisd(XMM0, XMM1, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_ja(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Int Float
-    else if (sameType(type1, Int)) {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM1, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        // convert Int to Float
-        emit_mov(c, RAX, s);
-        emit_int_to_float(RAX, XMM0, s);
-        delete c;
-        emit_ucompisd(XMM1, XMM0, s);
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_ja(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
-        // case: Float, Int
-    else {
-        const char *c = operandStack.top();
-        operandStack.pop();
-        // convert Int to Float
-        emit_mov(c, RAX, s);
-        emit_int_to_float(RAX, XMM0, s);
-        delete c;
-        c = operandStack.top();
-        operandStack.pop();
-        emit_movsd(c, XMM1, s);
-        emit_ucompisd(XMM0, XMM1, s);
-        delete c;
-        int tmp = pos_available;
-        int pos = pos_available;
-        int digit = 0;
-        if (tmp == 0) digit = 1;
-        else
-            while (tmp != 0) {
-                ++digit;
-                tmp /= 10;
-            }
-        char pos_char[digit + 6];
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_ja(pos_char, s);
-        // res = 0
-        emit_mov("$0", RAX, s);
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_jmp(pos_char, s);
-        // res = 1 in new branch
-        sprintf(pos_char, "%s%d", POSITION, pos);
-        emit_position(pos_char, s);
-        emit_mov("$1", RAX, s);
-        // store the result in this must-pass branch
-        sprintf(pos_char, "%s%d", POSITION, pos + 1);
-        emit_position(pos_char, s);
-        int len = count_len_addr_reg_shift(RBP, res_addr);
-        char reg[len];
-        addr_reg_shift(reg, RBP, res_addr);
-        emit_mov(RAX, reg, s);
-
-        // update available POS name, consuming 2
-        pos_available += 2;
-
-        // put result into the operandStack
-        char *str = new char[len];
-        strcpy(str, reg);
-        operandStack.push(str);
-    }
+    code_compare(e1, e2, IR_GT, s);
 
     if (cgen_debug) cout << "--- Gt_class::code ---\n";
 }
@@ -2854,37 +2146,19 @@ void And_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- And_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    e2->code(s);
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    const char *c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RDX, s);
-    delete c;
-    c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RAX, s);
-    emit_and(RAX, RDX, s);
-
-    int len = count_len_addr_reg_shift(RDX, res_addr);
-    char reg[len];
-    addr_reg_shift(reg, RDX, res_addr);
-    emit_mov(RDX, reg, s);
-
-    // put result into the operandStack
-    char *str = new char[len];
-    strcpy(str, reg);
-    operandStack.push(str);
+    code_condition_value(this, s);
 
     if (cgen_debug) cout << "--- And_class::code ---\n";
 }
 
+// e1 && e2: e2 only runs when e1 holds
+void And_class::code_branch(int on_true, int on_false, ostream &s) {
+    int rhs_block = curr_fn->new_block();
+    code_condition(e1, rhs_block, on_false, s);
+    curr_block = rhs_block;
+    code_condition(e2, on_true, on_false, s);
+}
+
 void Or_class::code(ostream &s) {
     if (init_once) {
         e1->code(s);
@@ -2893,37 +2167,19 @@ void Or_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Or_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    e2->code(s);
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    const char *c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RDX, s);
-    delete c;
-    c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RAX, s);
-    emit_or(RAX, RDX, s);
-
-    int len = count_len_addr_reg_shift(RDX, res_addr);
-    char reg[len];
-    addr_reg_shift(reg, RDX, res_addr);
-    emit_mov(RDX, reg, s);
-
-    // put result into the operandStack
-    char *str = new char[len];
-    strcpy(str, reg);
-    operandStack.push(str);
+    code_condition_value(this, s);
 
     if (cgen_debug) cout << "--- Or_class::code ---\n";
 }
 
+// e1 || e2: e2 only runs when e1 fails
+void Or_class::code_branch(int on_true, int on_false, ostream &s) {
+    int rhs_block = curr_fn->new_block();
+    code_condition(e1, on_true, rhs_block, s);
+    curr_block = rhs_block;
+    code_condition(e2, on_true, on_false, s);
+}
+
 void Xor_class::code(ostream &s) {
     if (init_once) {
         e1->code(s);
@@ -2932,34 +2188,7 @@ void Xor_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Xor_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    e2->code(s);
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    const char *c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RDX, s);
-    delete c;
-    c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RAX, s);
-    delete c;
-    emit_xor(RAX, RDX, s);
-
-    int len = count_len_addr_reg_shift(RBP, res_addr);
-    char reg[len];
-    addr_reg_shift(reg, RBP, res_addr);
-    emit_mov(RBP, reg, s);
-
-    // put result into the operandStack
-    char *str = new char[len];
-    strcpy(str, reg);
-    operandStack.push(str);
+    code_logic(e1, e2, IR_XOR, s);
 
     if (cgen_debug) cout << "--- Xor_class::code ---\n";
 }
@@ -2971,33 +2200,19 @@ void Not_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Not_class::code ---\n";
 
-    // caution: their order
     e1->code(s);
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    const char *c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RAX, s);
-    delete c;
-    emit_mov("$0x0000000000000001", RDX, s);
-    emit_xor(RDX, RAX, s);
-    int len = count_len_addr_reg_shift(RBP, res_addr);
-    char reg[len];
-    addr_reg_shift(reg, RBP, res_addr);
-    emit_mov(RAX, reg, s);
-
-    // put result into the operandStack
-    char *str = new char[len];
-    strcpy(str, reg);
-    operandStack.push(str);
+    IrOperand c = pop_operand();
+    IrOperand res = new_value(false);
+    ir_emit(ir_binary(IR_XOR, res, c, ir_imm(1)));
+    operandStack.push(res);
 
     if (cgen_debug) cout << "--- Not_class::code ---\n";
 }
 
+void Not_class::code_branch(int on_true, int on_false, ostream &s) {
+    code_condition(e1, on_false, on_true, s);
+}
+
 void Bitnot_class::code(ostream &s) {
     if (init_once) {
         e1->code(s);
@@ -3005,28 +2220,11 @@ void Bitnot_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Bitnot_class::code ---\n";
 
-    // caution: their order
     e1->code(s);
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    const char *c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RAX, s);
-    delete c;
-    emit_not(RAX, s);
-    int len = count_len_addr_reg_shift(RBP, res_addr);
-    char reg[len];
-    addr_reg_shift(reg, RBP, res_addr);
-    emit_mov(RAX, reg, s);
-
-    // put result into the operandStack
-    char *str = new char[len];
-    strcpy(str, reg);
-    operandStack.push(str);
+    IrOperand c = pop_operand();
+    IrOperand res = new_value(false);
+    ir_emit(ir_unary(IR_NOT, res, c));
+    operandStack.push(res);
 
     if (cgen_debug) cout << "--- Bitnot_class::code ---\n";
 }
@@ -3034,37 +2232,12 @@ void Bitnot_class::code(ostream &s) {
 void Bitand_class::code(ostream &s) {
     if (init_once) {
         e1->code(s);
+        e2->code(s);
         return;
     }
     if (cgen_debug) cout << "--- Bitand_class::code ---\n";
 
-    // caution: their order
-    e1->code(s);
-    e2->code(s);
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    const char *c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RDX, s);
-    delete c;
-    c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RAX, s);
-    delete c;
-    emit_and(RAX, RDX, s);
-    int len = count_len_addr_reg_shift(RBP, res_addr);
-    char reg[len];
-    addr_reg_shift(reg, RBP, res_addr);
-    emit_mov(RDX, reg, s);
-
-    // put result into the operandStack
-    char *str = new char[len];
-    strcpy(str, reg);
-    operandStack.push(str);
+    code_logic(e1, e2, IR_AND, s);
 
     if (cgen_debug) cout << "--- Bitand_class::code ---\n";
 }
@@ -3072,39 +2245,14 @@ void Bitand_class::code(ostream &s) {
 void Bitor_class::code(ostream &s) {
     if (init_once) {
         e1->code(s);
+        e2->code(s);
         return;
     }
-    if (cgen_debug) cout << "--- Bitand_class::code ---\n";
-
-    // caution: their order
-    e1->code(s);
-    e2->code(s);
-
-    // get stack space ready for the result
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    int res_addr = curr_usage;
-    // compute the result
-    const char *c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RDX, s);
-    delete c;
-    c = operandStack.top();
-    operandStack.pop();
-    emit_mov(c, RAX, s);
-    delete c;
-    emit_or(RAX, RDX, s);
-    int len = count_len_addr_reg_shift(RBP, res_addr);
-    char reg[len];
-    addr_reg_shift(reg, RBP, res_addr);
-    emit_mov(RDX, reg, s);
+    if (cgen_debug) cout << "--- Bitor_class::code ---\n";
 
-    // put result into the operandStack
-    char *str = new char[len];
-    strcpy(str, reg);
-    operandStack.push(str);
+    code_logic(e1, e2, IR_OR, s);
 
-    if (cgen_debug) cout << "--- Bitand_class::code ---\n";
+    if (cgen_debug) cout << "--- Bitor_class::code ---\n";
 }
 
 void Const_int_class::code(ostream &s) {
@@ -3113,65 +2261,23 @@ void Const_int_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Const_int_class::code ---\n";
 
-    // get stack space
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    // assign the value -> %rax -> addr
-    char val[strlen(value->get_string()) + 1] = "$";
-    for (int i = 0; i <= int(strlen(value->get_string())); ++i)
-        val[i + 1] = value->get_string()[i];
-    emit_mov(val, RAX, s);
-    int len = count_len_addr_reg_shift(RBP, curr_usage);
-    char reg[len];
-    addr_reg_shift(reg, RBP, curr_usage);
-    emit_mov(RAX, reg, s);
-    // push into the operandStack
-    char *c = new char[len];
-    strcpy(c, reg);
-    operandStack.push(c);
+    // decimal, 0x hex and 0 octal, as the assembler used to read them
+    operandStack.push(ir_imm(strtoll(value->get_string(), NULL, 0)));
 
     if (cgen_debug) cout << "--- Const_int_class::code ---\n";
 }
 
 void Const_string_class::code(ostream &s) {
     if (init_once) {
-        stringtable.add_string(value->get_string());
+        // bind the literal to its stringtable entry, whose index names its .LC label
+        value = stringtable.add_string(value->get_string());
         return;
     }
 
     if (cgen_debug) cout << "--- Const_string_class::code ---\n";
-    // get stack space
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
     // get .LCX
-    int tmp = -1;
-    for (int i = stringtable.first(); stringtable.more(i); i = stringtable.next(i))
-        if (strcmp(stringtable.lookup(i)->get_string(), value->get_string()) == 0) tmp = i;
-    int digit = 0;
-    if (tmp == 0) digit = 1;
-    else
-        while (tmp != 0) {
-            ++digit;
-            tmp /= 10;
-        }
-    char *c1 = new char[digit + 5];
-    strcpy(c1, "$.LC");
-    char c2[digit + 1];
-    sprintf(c2, "%d", tmp);
-    for (int i = 0; i < int(strlen(c2)); ++i) {
-        c1[4 + i] = c2[i];
-    }
-    c1[digit + 4] = '\0';
-    // assign the value -> %rax -> addr
-    emit_mov(c1, RAX, s);
-    int len = count_len_addr_reg_shift(RBP, curr_usage);
-    char reg[len];
-    addr_reg_shift(reg, RBP, curr_usage);
-    emit_mov(RAX, reg, s);
-    // push into the operandStack
-    char *c = new char[len];
-    strcpy(c, reg);
-    operandStack.push(c);
+    operandStack.push(ir_string(value->get_index()));
+
     if (cgen_debug) cout << "--- Const_string_class::code ---\n";
 }
 
@@ -3181,43 +2287,10 @@ void Const_float_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Const_float_class::code ---\n";
 
-    // get stack space
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
     // convert string to double
-    int decimal = 0;
-    for (int i = 0; i < value->get_len(); ++i)
-        if (value->get_string()[i] == '.') decimal = i;
-    double digit = 0;
-    for (int i = 0; i < value->get_len(); ++i) {
-        if (i == decimal) continue;
-        if (i < decimal)
-            digit += (value->get_string()[i] - '0') * pow(10, decimal - 1 - i);
-        else
-            digit += (value->get_string()[i] - '0') * pow(10, decimal - i);
-    }
-    // convert double to hex byte to byte
-    char tmp[19] = "$0x";
-    unsigned char *p = (unsigned char *) (&digit);
-    int idx = 3;
-    for (int i = sizeof(digit) - 1; i >= 0; --i) {
-        char s[3];
-        sprintf(s, "%02x", static_cast<int>(*(p + i)));
-        tmp[idx++] = s[0];
-        tmp[idx++] = s[1];
-    }
-    tmp[idx] = '\0';
-    if (cgen_debug) cout << "Finish convertion from double " << digit << " to hex " << tmp << ".\n";
-    // assign the value -> %rax -> addr
-    emit_mov(tmp, RAX, s);
-    int len = count_len_addr_reg_shift(RBP, curr_usage);
-    char reg[len];
-    addr_reg_shift(reg, RBP, curr_usage);
-    emit_mov(RAX, reg, s);
-    // push into the operandStack
-    char *c = new char[len];
-    strcpy(c, reg);
-    operandStack.push(c);
+    double digit = atof(value->get_string());
+    if (cgen_debug) cout << "Finish convertion to double " << digit << ".\n";
+    operandStack.push(ir_fimm(digit));
 
     if (cgen_debug) cout << "--- Const_float_class::code ---\n";
 }
@@ -3228,21 +2301,7 @@ void Const_bool_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- Const_bool_class::code ---\n";
 
-    // get stack space
-    emit_sub("$8", RSP, s);
-    curr_usage += 8;
-    // assign the value -> %rax -> addr
-    char tmp[3] = "$1";
-    if (!value) tmp[1] = '0';
-    emit_mov(tmp, RAX, s);
-    int len = count_len_addr_reg_shift(RBP, curr_usage);
-    char reg[len];
-    addr_reg_shift(reg, RBP, curr_usage);
-    emit_mov(RAX, reg, s);
-    // push into the operandStack
-    char *c = new char[len];
-    strcpy(c, reg);
-    operandStack.push(c);
+    operandStack.push(ir_imm(value ? 1 : 0));
 
     if (cgen_debug) cout << "--- Const_bool_class::code ---\n";
 }
@@ -3252,12 +2311,16 @@ void Object_class::code(ostream &s) {
         return;
     }
     if (cgen_debug) cout << "--- Object_class::code ---\n";
-    // lookup its addr in varNameToAddr
-    int pos = *(varNameToAddr.lookup(var));
-    char *addr = new char[strlen(name_proc[pos])];
-    strcpy(addr, name_proc[pos]);
-    // put addr into the operandStack
-    operandStack.push(addr);
+    // lookup its operand in varNameToAddr
+    IrOperand operand = name_proc[*varNameToAddr.lookup(var)];
+    if (!operand.is_vreg()) {
+        // read the global now
+        IrOperand res = new_value(operand.is_float);
+        ir_emit(ir_mov(res, operand));
+        operand = res;
+    }
+    // put it into the operandStack
+    operandStack.push(operand);
 
     if (cgen_debug) cout << "--- Object_class::code ---\n";
 }
@@ -3268,8 +2331,7 @@ void No_expr_class::code(ostream &s) {
     }
     if (cgen_debug) cout << "--- No_expr_class::code ---\n";
 
-    const char *c = nullptr;
-    operandStack.push(c);
+    operandStack.push(ir_none());
 
     if (cgen_debug) cout << "--- No_expr_class::code ---\n";
-}
\ No newline at end of file
+}
@@ -0,0 +1,165 @@
+//**************************************************************
+//
+// Machine instructions: operands, records and their text.
+//
+//**************************************************************
+
+#include "cgen_asm.h"
+#include "emit.h"
+#include <stdio.h>
+#include <string.h>
+
+using namespace std;
+
+AsmOperand asm_operand(AsmOperandKind kind) {
+    AsmOperand o;
+    o.kind = kind;
+    o.reg = NULL;
+    o.index = NULL;
+    o.offset = 0;
+    o.imm = 0;
+    o.name = NULL;
+    return o;
+}
+
+AsmOperand asm_reg(const char *reg) {
+    bool vector = strncmp(reg, "%xmm", 4) == 0 || strncmp(reg, "%ymm", 4) == 0;
+    AsmOperand o = asm_operand(vector ? ASM_XMM : ASM_REG);
+    o.reg = reg;
+    return o;
+}
+
+AsmOperand asm_mem(const char *base, int offset) {
+    AsmOperand o = asm_operand(ASM_MEM);
+    o.reg = base;
+    o.offset = offset;
+    return o;
+}
+
+AsmOperand asm_indexed(const char *base, const char *index, int scale) {
+    AsmOperand o = asm_operand(ASM_INDEXED);
+    o.reg = base;
+    o.index = index;
+    o.offset = scale;
+    return o;
+}
+
+AsmOperand asm_imm(long long value) {
+    AsmOperand o = asm_operand(ASM_IMM);
+    o.imm = value;
+    return o;
+}
+
+AsmOperand asm_block(const char *prefix, long long index) {
+    AsmOperand o = asm_operand(ASM_BLOCK);
+    o.name = prefix;
+    o.imm = index;
+    return o;
+}
+
+AsmOperand asm_symbol(const char *name) {
+    AsmOperand o = asm_operand(ASM_SYMBOL);
+    o.name = name;
+    return o;
+}
+
+AsmText asm_text(const AsmOperand &o) {
+    AsmText t;
+    switch (o.kind) {
+        case ASM_REG:
+        case ASM_XMM:
+            strcpy(t.str, o.reg);
+            break;
+        case ASM_MEM:
+            sprintf(t.str, "%d(%s)", o.offset, o.reg);
+            break;
+        case ASM_INDEXED:
+            sprintf(t.str, "(%s, %s, %d)", o.reg, o.index, o.offset);
+            break;
+        case ASM_GLOBAL:
+            sprintf(t.str, "%s(%s)", o.name, RIP);
+            break;
+        case ASM_IMM:
+            sprintf(t.str, "$%lld", o.imm);
+            break;
+        case ASM_LABEL:
+            sprintf(t.str, "$%s%lld", o.name, o.imm);
+            break;
+        case ASM_CONST:
+            sprintf(t.str, "%s%lld(%s)", o.name, o.imm, RIP);
+            break;
+        case ASM_BLOCK:
+            sprintf(t.str, "%s%lld", o.name, o.imm);
+            break;
+        case ASM_SYMBOL:
+            strcpy(t.str, o.name);
+            break;
+        case ASM_NONE:
+            t.str[0] = '\0';
+            break;
+    }
+    return t;
+}
+
+bool same_operand(const AsmOperand &a, const AsmOperand &b) {
+    if (a.kind != b.kind) return false;
+    switch (a.kind) {
+        case ASM_REG:
+        case ASM_XMM: return strcmp(a.reg, b.reg) == 0;
+        case ASM_MEM: return strcmp(a.reg, b.reg) == 0 && a.offset == b.offset;
+        case ASM_INDEXED:
+            return strcmp(a.reg, b.reg) == 0 && strcmp(a.index, b.index) == 0 && a.offset == b.offset;
+        case ASM_GLOBAL:
+        case ASM_SYMBOL: return strcmp(a.name, b.name) == 0;
+        case ASM_IMM: return a.imm == b.imm;
+        case ASM_LABEL:
+        case ASM_CONST:
+        case ASM_BLOCK: return strcmp(a.name, b.name) == 0 && a.imm == b.imm;
+        default: return true;
+    }
+}
+
+bool reads_reg(const AsmOperand &o, const AsmOperand &reg) {
+    if (!is_reg(reg)) return false;
+    switch (o.kind) {
+        case ASM_REG:
+        case ASM_XMM:
+        case ASM_MEM: return strcmp(o.reg, reg.reg) == 0;
+        case ASM_INDEXED: return strcmp(o.reg, reg.reg) == 0 || strcmp(o.index, reg.reg) == 0;
+        default: return false;
+    }
+}
+
+bool is_xmm(const AsmOperand &o) {
+    return o.kind == ASM_XMM;
+}
+
+bool is_reg(const AsmOperand &o) {
+    return o.kind == ASM_REG || o.kind == ASM_XMM;
+}
+
+bool is_imm(const AsmOperand &o) {
+    return o.kind == ASM_IMM || o.kind == ASM_LABEL;
+}
+
+bool is_mem(const AsmOperand &o) {
+    return o.kind == ASM_MEM || o.kind == ASM_GLOBAL || o.kind == ASM_CONST;
+}
+
+bool is_op(const AsmInstr &instr, const char *op) {
+    return instr.op != NULL && strcmp(instr.op, op) == 0;
+}
+
+void asm_write(const AsmCode &code, ostream &s) {
+    for (unsigned int i = 0; i < code.size(); ++i) {
+        const AsmInstr &instr = code[i];
+        if (instr.op == NULL) {
+            s << asm_text(instr.args[0]).str << ":" << endl;
+            continue;
+        }
+        s << instr.op;
+        for (unsigned int a = 0; a < instr.args.size(); ++a)
+            s << (a ? COMMA : "") << asm_text(instr.args[a]).str;
+        s << endl;
+    }
+}
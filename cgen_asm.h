@@ -0,0 +1,81 @@
+//**************************************************************
+//
+// Machine instructions of the code generator
+//
+// Instruction selection (cgen.cc) records each instruction of a
+// function as an opcode of emit.h and a list of operands.  The
+// peephole optimiser rewrites the records, and only then are they
+// written out as assembly text.
+//
+//**************************************************************
+
+#ifndef CGEN_ASM_H
+#define CGEN_ASM_H
+
+#include <iostream>
+#include <vector>
+
+using std::ostream;
+using std::vector;
+
+#define OPERAND_SIZE 64  // room for any operand text
+
+enum AsmOperandKind {
+    ASM_NONE,
+    ASM_REG,      // general purpose register
+    ASM_XMM,      // xmm or ymm register
+    ASM_MEM,      // offset(base)
+    ASM_INDEXED,  // (base, index, scale)
+    ASM_GLOBAL,   // name(%rip)
+    ASM_IMM,      // $imm
+    ASM_LABEL,    // $<prefix><index>, the address of a constant
+    ASM_CONST,    // <prefix><index>(%rip), a constant in .rodata
+    ASM_BLOCK,    // <prefix><index>, the label of a block
+    ASM_SYMBOL    // name, a function
+};
+
+struct AsmOperand {
+    AsmOperandKind kind;
+    const char *reg;      // ASM_REG, ASM_XMM; the base of ASM_MEM, ASM_INDEXED
+    const char *index;    // the index register of ASM_INDEXED
+    int offset;           // ASM_MEM; the scale of ASM_INDEXED
+    long long imm;        // ASM_IMM; the index of ASM_LABEL, ASM_CONST, ASM_BLOCK
+    const char *name;     // ASM_GLOBAL, ASM_SYMBOL; the prefix of ASM_LABEL, ASM_CONST, ASM_BLOCK
+};
+
+// the assembly text of an operand, formatted on demand
+struct AsmText {
+    char str[OPERAND_SIZE];
+};
+
+AsmOperand asm_operand(AsmOperandKind kind);
+AsmOperand asm_reg(const char *reg);
+AsmOperand asm_mem(const char *base, int offset);
+AsmOperand asm_indexed(const char *base, const char *index, int scale);
+AsmOperand asm_imm(long long value);
+AsmOperand asm_block(const char *prefix, long long index);
+AsmOperand asm_symbol(const char *name);
+AsmText asm_text(const AsmOperand &o);
+bool same_operand(const AsmOperand &a, const AsmOperand &b);
+// whether reading o reads register reg, e.g. as the base of an address
+bool reads_reg(const AsmOperand &o, const AsmOperand &reg);
+
+bool is_xmm(const AsmOperand &o);
+bool is_reg(const AsmOperand &o);
+bool is_imm(const AsmOperand &o);
+bool is_mem(const AsmOperand &o);
+
+// one instruction, or the label of a block when op is NULL
+struct AsmInstr {
+    const char *op;             // an opcode of emit.h
+    vector<AsmOperand> args;    // sources first, the destination last
+};
+
+typedef vector<AsmInstr> AsmCode;
+
+bool is_op(const AsmInstr &instr, const char *op);
+
+// write the instructions out as assembly text
+void asm_write(const AsmCode &code, ostream &s);
+
+#endif
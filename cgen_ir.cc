@@ -0,0 +1,661 @@
+//**************************************************************
+//
+// Intermediate representation: construction, CFG, liveness,
+// register allocation and the debug dump.
+//
+//**************************************************************
+
+#include "cgen_ir.h"
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////
+//
+//    Operands and instructions
+//
+//////////////////////////////////////////////////////////////////
+
+static IrOperand make_operand(IrOperandKind kind, bool is_float) {
+    IrOperand o;
+    o.kind = kind;
+    o.is_float = is_float;
+    o.vreg = -1;
+    o.imm = 0;
+    o.fimm = 0;
+    o.name = NULL;
+    return o;
+}
+
+IrOperand ir_none() {
+    return make_operand(IR_NONE, false);
+}
+
+IrOperand ir_vreg(int vreg, bool is_float) {
+    IrOperand o = make_operand(IR_VREG, is_float);
+    o.vreg = vreg;
+    return o;
+}
+
+IrOperand ir_imm(long long value) {
+    IrOperand o = make_operand(IR_IMM, false);
+    o.imm = value;
+    return o;
+}
+
+IrOperand ir_fimm(double value) {
+    IrOperand o = make_operand(IR_FIMM, true);
+    o.fimm = value;
+    return o;
+}
+
+IrOperand ir_global(const char *name, bool is_float) {
+    IrOperand o = make_operand(IR_GLOBAL, is_float);
+    o.name = name;
+    return o;
+}
+
+IrOperand ir_string(int index) {
+    IrOperand o = make_operand(IR_STRING, false);
+    o.imm = index;
+    return o;
+}
+
+bool IrOperand::same(const IrOperand &o) const {
+    if (kind != o.kind) return false;
+    switch (kind) {
+        case IR_NONE:
+            return true;
+        case IR_VREG:
+            return vreg == o.vreg;
+        case IR_IMM:
+        case IR_STRING:
+            return imm == o.imm;
+        case IR_FIMM:
+            return memcmp(&fimm, &o.fimm, sizeof(double)) == 0;
+        case IR_GLOBAL:
+            return strcmp(name, o.name) == 0;
+    }
+    return false;
+}
+
+int IrFunction::new_vreg(bool is_float) {
+    vreg_is_float.push_back(is_float);
+    vreg_is_packed.push_back(false);
+    return vreg_is_float.size() - 1;
+}
+
+int IrFunction::new_packed_vreg() {
+    int vreg = new_vreg(true);
+    vreg_is_packed[vreg] = true;
+    return vreg;
+}
+
+int IrFunction::new_block() {
+    IrBlock b;
+    b.id = blocks.size();
+    blocks.push_back(b);
+    return b.id;
+}
+
+static IrInstr make_instr(IrOpcode op) {
+    IrInstr i;
+    i.op = op;
+    i.dst = ir_none();
+    i.a = ir_none();
+    i.b = ir_none();
+    i.callee = NULL;
+    i.target = -1;
+    i.target2 = -1;
+    return i;
+}
+
+IrInstr ir_mov(IrOperand dst, IrOperand a) {
+    IrInstr i = make_instr(IR_MOV);
+    i.dst = dst;
+    i.a = a;
+    return i;
+}
+
+IrInstr ir_unary(IrOpcode op, IrOperand dst, IrOperand a) {
+    IrInstr i = make_instr(op);
+    i.dst = dst;
+    i.a = a;
+    return i;
+}
+
+IrInstr ir_binary(IrOpcode op, IrOperand dst, IrOperand a, IrOperand b) {
+    IrInstr i = make_instr(op);
+    i.dst = dst;
+    i.a = a;
+    i.b = b;
+    return i;
+}
+
+IrInstr ir_call(IrOperand dst, const char *callee, const vector<IrOperand> &args) {
+    IrInstr i = make_instr(IR_CALL);
+    i.dst = dst;
+    i.callee = callee;
+    i.args = args;
+    return i;
+}
+
+IrInstr ir_jmp(int target) {
+    IrInstr i = make_instr(IR_JMP);
+    i.target = target;
+    return i;
+}
+
+IrInstr ir_br(IrOperand cond, int target, int target2) {
+    IrInstr i = make_instr(IR_BR);
+    i.a = cond;
+    i.target = target;
+    i.target2 = target2;
+    return i;
+}
+
+IrInstr ir_ret(IrOperand a) {
+    IrInstr i = make_instr(IR_RET);
+    i.a = a;
+    return i;
+}
+
+IrInstr ir_pack(IrOperand dst, const vector<IrOperand> &lanes) {
+    IrInstr i = make_instr(IR_VPACK);
+    i.dst = dst;
+    i.args = lanes;
+    return i;
+}
+
+IrInstr ir_lane(IrOperand dst, IrOperand a, int lane) {
+    IrInstr i = make_instr(IR_VLANE);
+    i.dst = dst;
+    i.a = a;
+    i.b = ir_imm(lane);
+    return i;
+}
+
+IrInstr ir_vend() {
+    return make_instr(IR_VEND);
+}
+
+void ir_uses(const IrInstr &instr, vector<IrOperand> &uses) {
+    uses.clear();
+    if (instr.a.kind != IR_NONE) uses.push_back(instr.a);
+    if (instr.b.kind != IR_NONE) uses.push_back(instr.b);
+    for (unsigned int i = 0; i < instr.args.size(); ++i) uses.push_back(instr.args[i]);
+    // a store to a global reads nothing from dst, a vreg dst is a def
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    CFG and liveness
+//
+//////////////////////////////////////////////////////////////////
+
+void ir_build_cfg(IrFunction &fn) {
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b) {
+        fn.blocks[b].succs.clear();
+        fn.blocks[b].preds.clear();
+    }
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b) {
+        IrBlock &block = fn.blocks[b];
+        // anything after the first terminator can never run
+        for (unsigned int i = 0; i < block.instrs.size(); ++i)
+            if (block.instrs[i].is_terminator()) {
+                block.instrs.resize(i + 1);
+                break;
+            }
+        if (block.instrs.empty() || !block.instrs.back().is_terminator())
+            continue;
+        const IrInstr &last = block.instrs.back();
+        if (last.op == IR_JMP) block.succs.push_back(last.target);
+        else if (last.op == IR_BR) {
+            block.succs.push_back(last.target);
+            if (last.target2 != last.target) block.succs.push_back(last.target2);
+        }
+    }
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b)
+        for (unsigned int i = 0; i < fn.blocks[b].succs.size(); ++i)
+            fn.blocks[fn.blocks[b].succs[i]].preds.push_back(b);
+}
+
+void ir_remove_unreachable(IrFunction &fn) {
+    int nblocks = fn.blocks.size();
+    vector<bool> reached(nblocks, false);
+    vector<int> work(1, 0);
+    reached[0] = true;
+    while (!work.empty()) {
+        int b = work.back();
+        work.pop_back();
+        for (unsigned int s = 0; s < fn.blocks[b].succs.size(); ++s)
+            if (!reached[fn.blocks[b].succs[s]]) {
+                reached[fn.blocks[b].succs[s]] = true;
+                work.push_back(fn.blocks[b].succs[s]);
+            }
+    }
+    // close up the gaps, keeping the layout order
+    vector<int> new_id(nblocks, -1);
+    int kept = 0;
+    for (int b = 0; b < nblocks; ++b)
+        if (reached[b]) new_id[b] = kept++;
+    if (kept == nblocks) return;
+    for (int b = 0; b < nblocks; ++b) {
+        if (!reached[b]) continue;
+        IrBlock &block = fn.blocks[new_id[b]];
+        if (new_id[b] != b) block = fn.blocks[b];
+        block.id = new_id[b];
+        if (block.instrs.empty()) continue;
+        IrInstr &last = block.instrs.back();
+        if (last.op == IR_JMP || last.op == IR_BR) {
+            last.target = new_id[last.target];
+            if (last.op == IR_BR) last.target2 = new_id[last.target2];
+        }
+    }
+    fn.blocks.resize(kept);
+    ir_build_cfg(fn);
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    Tail calls
+//
+//    A block that ends in a call whose result is returned at once
+//    needs nothing of the current frame after the call.  A call of
+//    the function itself becomes a loop: the arguments are copied
+//    into the parameters and control goes back to the entry block.
+//    Any other callee is reached through IR_TAILCALL, which leaves
+//    the frame before jumping to it.
+//
+//////////////////////////////////////////////////////////////////
+
+void ir_tail_calls(IrFunction &fn) {
+    bool changed = false;
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b) {
+        vector<IrInstr> &instrs = fn.blocks[b].instrs;
+        int n = instrs.size();
+        if (n < 2 || instrs[n - 1].op != IR_RET || instrs[n - 2].op != IR_CALL) continue;
+        const IrInstr &ret = instrs[n - 1];
+        IrInstr call = instrs[n - 2];
+        if (ret.a.kind != IR_NONE && !(ret.a.is_vreg() && call.has_dst() && ret.a.vreg == call.dst.vreg))
+            continue;
+        instrs.resize(n - 2);
+        if (strcmp(call.callee, fn.name) == 0) {
+            // the arguments may read the parameters: copy them all out first
+            vector<IrOperand> values;
+            for (unsigned int a = 0; a < call.args.size(); ++a) {
+                IrOperand v = call.args[a];
+                if (v.is_vreg()) {
+                    v = ir_vreg(fn.new_vreg(v.is_float), v.is_float);
+                    instrs.push_back(ir_mov(v, call.args[a]));
+                }
+                values.push_back(v);
+            }
+            for (unsigned int a = 0; a < values.size(); ++a)
+                instrs.push_back(ir_mov(fn.params[a], values[a]));
+            instrs.push_back(ir_jmp(0));
+        }
+        else {
+            call.op = IR_TAILCALL;
+            call.dst = ir_none();
+            instrs.push_back(call);
+        }
+        changed = true;
+    }
+    if (changed) ir_build_cfg(fn);
+}
+
+void ir_liveness(const IrFunction &fn, IrLiveness &live) {
+    int nblocks = fn.blocks.size();
+    int nvregs = fn.vreg_count();
+    vector<vector<bool> > use(nblocks, vector<bool>(nvregs, false));
+    vector<vector<bool> > def(nblocks, vector<bool>(nvregs, false));
+    vector<IrOperand> uses;
+    for (int b = 0; b < nblocks; ++b) {
+        const IrBlock &block = fn.blocks[b];
+        for (unsigned int i = 0; i < block.instrs.size(); ++i) {
+            ir_uses(block.instrs[i], uses);
+            for (unsigned int u = 0; u < uses.size(); ++u)
+                if (uses[u].is_vreg() && !def[b][uses[u].vreg]) use[b][uses[u].vreg] = true;
+            if (block.instrs[i].has_dst()) def[b][block.instrs[i].dst.vreg] = true;
+        }
+    }
+    live.live_in.assign(nblocks, vector<bool>(nvregs, false));
+    live.live_out.assign(nblocks, vector<bool>(nvregs, false));
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int b = nblocks - 1; b >= 0; --b) {
+            const IrBlock &block = fn.blocks[b];
+            vector<bool> out(nvregs, false);
+            for (unsigned int s = 0; s < block.succs.size(); ++s) {
+                const vector<bool> &in = live.live_in[block.succs[s]];
+                for (int v = 0; v < nvregs; ++v)
+                    if (in[v]) out[v] = true;
+            }
+            vector<bool> in(nvregs, false);
+            for (int v = 0; v < nvregs; ++v)
+                in[v] = use[b][v] || (out[v] && !def[b][v]);
+            if (in != live.live_in[b] || out != live.live_out[b]) {
+                live.live_in[b] = in;
+                live.live_out[b] = out;
+                changed = true;
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    Linear scan register allocation
+//
+//////////////////////////////////////////////////////////////////
+
+struct Interval {
+    int vreg;
+    int start;
+    int end;
+};
+
+static bool by_start(const Interval &x, const Interval &y) {
+    if (x.start != y.start) return x.start < y.start;
+    return x.vreg < y.vreg;
+}
+
+static void extend(vector<Interval> &intervals, int vreg, int pos) {
+    Interval &it = intervals[vreg];
+    if (it.start < 0 || pos < it.start) it.start = pos;
+    if (pos > it.end) it.end = pos;
+}
+
+// how deep in loops each block sits; loops are laid out from their
+// header down to the block that jumps back to it
+static void loop_depths(const IrFunction &fn, vector<int> &depth) {
+    depth.assign(fn.blocks.size(), 0);
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b)
+        for (unsigned int s = 0; s < fn.blocks[b].succs.size(); ++s)
+            for (unsigned int k = fn.blocks[b].succs[s]; k <= b; ++k) ++depth[k];
+}
+
+#define LOOP_WEIGHT 8     // a use in a loop counts as this many outside it
+#define MAX_LOOP_DEPTH 6
+
+// uses per position covered; a long interval used mostly outside loops is cheap to spill
+static double spill_cost(const Interval &it, const vector<double> &weight) {
+    return weight[it.vreg] / (it.end - it.start + 1);
+}
+
+// the free register of pool to give an interval, -1 if there is none
+static int free_register(const vector<int> &owner, const IrRegPool &pool, bool prefer_preserved) {
+    // the preserved registers first, or last
+    for (int pass = 0; pass < 2; ++pass)
+        for (int r = 0; r < pool.num; ++r)
+            if (owner[r] < 0 && (r < pool.preserved) == (prefer_preserved == (pass == 0))) return r;
+    return -1;
+}
+
+// hand out stack slots to the intervals, reusing a slot once its owner is dead
+static int assign_slots(vector<Interval> &spilled, IrAllocation &alloc) {
+    sort(spilled.begin(), spilled.end(), by_start);
+    vector<int> slot_end;   // last position each slot is busy until
+    for (unsigned int i = 0; i < spilled.size(); ++i) {
+        int slot = -1;
+        for (unsigned int s = 0; s < slot_end.size(); ++s)
+            if (slot_end[s] < spilled[i].start) {
+                slot = s;
+                break;
+            }
+        if (slot < 0) {
+            slot = slot_end.size();
+            slot_end.push_back(0);
+        }
+        slot_end[slot] = spilled[i].end;
+        alloc.loc[spilled[i].vreg].in_reg = false;
+        alloc.loc[spilled[i].vreg].slot = slot;
+    }
+    return slot_end.size();
+}
+
+void ir_allocate(const IrFunction &fn, const IrRegPool &int_pool, const IrRegPool &float_pool,
+                 bool stack_only, IrAllocation &alloc) {
+    int nvregs = fn.vreg_count();
+    IrLiveness live;
+    ir_liveness(fn, live);
+
+    // number the instructions along the block order; positions are even so
+    // that every instruction has a distinct point, parameters are defined at 0
+    vector<Interval> intervals(nvregs);
+    for (int v = 0; v < nvregs; ++v) {
+        intervals[v].vreg = v;
+        intervals[v].start = -1;
+        intervals[v].end = -1;
+    }
+    for (unsigned int p = 0; p < fn.params.size(); ++p)
+        extend(intervals, fn.params[p].vreg, 0);
+    vector<int> calls;
+    vector<IrOperand> uses;
+    vector<int> depth;
+    loop_depths(fn, depth);
+    vector<double> weight(nvregs, 0);
+    int pos = 2;
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b) {
+        const IrBlock &block = fn.blocks[b];
+        int block_start = pos;
+        double use_weight = pow(LOOP_WEIGHT, min(depth[b], MAX_LOOP_DEPTH));
+        for (unsigned int i = 0; i < block.instrs.size(); ++i, pos += 2) {
+            const IrInstr &instr = block.instrs[i];
+            ir_uses(instr, uses);
+            for (unsigned int u = 0; u < uses.size(); ++u)
+                if (uses[u].is_vreg()) {
+                    extend(intervals, uses[u].vreg, pos);
+                    weight[uses[u].vreg] += use_weight;
+                }
+            if (instr.has_dst()) {
+                extend(intervals, instr.dst.vreg, pos);
+                weight[instr.dst.vreg] += use_weight;
+            }
+            if (instr.op == IR_CALL) calls.push_back(pos);
+        }
+        int block_end = pos;
+        for (int v = 0; v < nvregs; ++v) {
+            if (live.live_in[b][v]) extend(intervals, v, block_start);
+            if (live.live_out[b][v]) extend(intervals, v, block_end);
+        }
+    }
+
+    // packed values have no stack slot to go to
+    for (int v = 0; v < nvregs; ++v)
+        if (fn.vreg_is_packed[v]) weight[v] = HUGE_VAL;
+
+    alloc.loc.assign(nvregs, IrLocation());
+    vector<Interval> sorted;
+    for (int v = 0; v < nvregs; ++v) {
+        alloc.loc[v].in_reg = false;
+        alloc.loc[v].reg = -1;
+        alloc.loc[v].slot = -1;
+        if (intervals[v].start >= 0) sorted.push_back(intervals[v]);
+    }
+    sort(sorted.begin(), sorted.end(), by_start);
+
+    vector<Interval> spilled;
+    vector<Interval> active[2];
+    vector<int> reg_owner[2];
+    reg_owner[0].assign(int_pool.num, -1);
+    reg_owner[1].assign(float_pool.num, -1);
+    for (unsigned int i = 0; i < sorted.size(); ++i) {
+        const Interval &cur = sorted[i];
+        int cls = fn.vreg_is_float[cur.vreg] ? 1 : 0;
+        const IrRegPool &pool = cls ? float_pool : int_pool;
+        // expire old intervals, a value read by the instruction that defines
+        // cur may share its register
+        for (int c = 0; c < 2; ++c)
+            for (unsigned int a = 0; a < active[c].size();) {
+                if (active[c][a].end <= cur.start) {
+                    reg_owner[c][alloc.loc[active[c][a].vreg].reg] = -1;
+                    active[c].erase(active[c].begin() + a);
+                }
+                else ++a;
+            }
+        bool crosses_call = false;
+        for (unsigned int c = 0; c < calls.size(); ++c)
+            if (cur.start < calls[c] && calls[c] < cur.end) crosses_call = true;
+        if (stack_only || pool.num == 0 || (crosses_call && !pool.survives_calls)) {
+            spilled.push_back(cur);
+            continue;
+        }
+        // without calls in the function, the pool order alone decides
+        int reg = free_register(reg_owner[cls], pool, crosses_call || calls.empty());
+        if (reg < 0) {
+            // spill whichever of the active intervals and cur is used least
+            // for its length, the one ending last among equals
+            unsigned int victim = 0;
+            for (unsigned int a = 1; a < active[cls].size(); ++a) {
+                double wa = spill_cost(active[cls][a], weight), wv = spill_cost(active[cls][victim], weight);
+                if (wa < wv || (wa == wv && active[cls][a].end > active[cls][victim].end)) victim = a;
+            }
+            double wv = spill_cost(active[cls][victim], weight), wc = spill_cost(cur, weight);
+            if (wv < wc || (wv == wc && active[cls][victim].end > cur.end)) {
+                reg = alloc.loc[active[cls][victim].vreg].reg;
+                alloc.loc[active[cls][victim].vreg].in_reg = false;
+                spilled.push_back(active[cls][victim]);
+                active[cls].erase(active[cls].begin() + victim);
+            }
+            else {
+                spilled.push_back(cur);
+                continue;
+            }
+        }
+        alloc.loc[cur.vreg].in_reg = true;
+        alloc.loc[cur.vreg].reg = reg;
+        reg_owner[cls][reg] = cur.vreg;
+        active[cls].push_back(cur);
+    }
+    alloc.slot_count = assign_slots(spilled, alloc);
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    Dump
+//
+//////////////////////////////////////////////////////////////////
+
+static const char *opcode_name(IrOpcode op) {
+    switch (op) {
+        case IR_MOV: return "mov";
+        case IR_ADD: return "add";
+        case IR_SUB: return "sub";
+        case IR_MUL: return "mul";
+        case IR_DIV: return "div";
+        case IR_MOD: return "mod";
+        case IR_AND: return "and";
+        case IR_OR: return "or";
+        case IR_XOR: return "xor";
+        case IR_FADD: return "fadd";
+        case IR_FSUB: return "fsub";
+        case IR_FMUL: return "fmul";
+        case IR_FDIV: return "fdiv";
+        case IR_NEG: return "neg";
+        case IR_NOT: return "not";
+        case IR_FNEG: return "fneg";
+        case IR_I2F: return "i2f";
+        case IR_LT: return "lt";
+        case IR_LE: return "le";
+        case IR_EQ: return "eq";
+        case IR_NE: return "ne";
+        case IR_GE: return "ge";
+        case IR_GT: return "gt";
+        case IR_CALL: return "call";
+        case IR_TAILCALL: return "tailcall";
+        case IR_JMP: return "jmp";
+        case IR_BR: return "br";
+        case IR_RET: return "ret";
+        case IR_VPACK: return "vpack";
+        case IR_VFADD: return "vfadd";
+        case IR_VFSUB: return "vfsub";
+        case IR_VFMUL: return "vfmul";
+        case IR_VFDIV: return "vfdiv";
+        case IR_VLANE: return "vlane";
+        case IR_VEND: return "vend";
+    }
+    return "?";
+}
+
+static void dump_operand(const IrOperand &o, ostream &s) {
+    switch (o.kind) {
+        case IR_NONE:
+            s << "_";
+            break;
+        case IR_VREG:
+            s << (o.is_float ? "f" : "v") << o.vreg;
+            break;
+        case IR_IMM:
+            s << o.imm;
+            break;
+        case IR_FIMM:
+            s << o.fimm << "f";
+            break;
+        case IR_GLOBAL:
+            s << "@" << o.name;
+            break;
+        case IR_STRING:
+            s << ".LC" << o.imm;
+            break;
+    }
+}
+
+void ir_dump(const IrFunction &fn, ostream &s) {
+    s << "function " << fn.name << "(";
+    for (unsigned int p = 0; p < fn.params.size(); ++p) {
+        if (p) s << ", ";
+        dump_operand(fn.params[p], s);
+    }
+    s << ")" << endl;
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b) {
+        const IrBlock &block = fn.blocks[b];
+        s << "B" << block.id << ":";
+        if (!block.preds.empty()) {
+            s << "\t\t; preds";
+            for (unsigned int p = 0; p < block.preds.size(); ++p) s << " B" << block.preds[p];
+        }
+        s << endl;
+        for (unsigned int i = 0; i < block.instrs.size(); ++i) {
+            const IrInstr &instr = block.instrs[i];
+            s << "\t";
+            if (instr.dst.kind != IR_NONE) {
+                dump_operand(instr.dst, s);
+                s << " = ";
+            }
+            s << opcode_name(instr.op);
+            if (instr.op == IR_VPACK) {
+                s << " {";
+                for (unsigned int a = 0; a < instr.args.size(); ++a) {
+                    if (a) s << ", ";
+                    dump_operand(instr.args[a], s);
+                }
+                s << "}";
+            }
+            if (instr.op == IR_CALL || instr.op == IR_TAILCALL) {
+                s << " " << instr.callee << "(";
+                for (unsigned int a = 0; a < instr.args.size(); ++a) {
+                    if (a) s << ", ";
+                    dump_operand(instr.args[a], s);
+                }
+                s << ")";
+            }
+            if (instr.a.kind != IR_NONE) {
+                s << " ";
+                dump_operand(instr.a, s);
+            }
+            if (instr.b.kind != IR_NONE) {
+                s << ", ";
+                dump_operand(instr.b, s);
+            }
+            if (instr.op == IR_JMP) s << " B" << instr.target;
+            if (instr.op == IR_BR) s << ", B" << instr.target << ", B" << instr.target2;
+            s << endl;
+        }
+    }
+    s << endl;
+}
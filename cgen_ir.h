@@ -0,0 +1,188 @@
+//**************************************************************
+//
+// Intermediate representation for the code generator
+//
+// The AST is lowered into three-address instructions grouped in
+// basic blocks.  Every block ends in exactly one terminator
+// (IR_JMP, IR_BR or IR_RET), and the CFG edges are read off those
+// terminators.  Values live in virtual registers; globals are
+// memory operands.  Instruction selection (cgen.cc) runs over this
+// form after the analyses below.
+//
+//**************************************************************
+
+#ifndef CGEN_IR_H
+#define CGEN_IR_H
+
+#include <iostream>
+#include <vector>
+
+using std::ostream;
+using std::vector;
+
+enum IrOperandKind {
+    IR_NONE,     // no operand (void call, empty return)
+    IR_VREG,     // virtual register
+    IR_IMM,      // 64-bit integer immediate (Int, Bool)
+    IR_FIMM,     // double immediate
+    IR_GLOBAL,   // global variable, a memory operand
+    IR_STRING    // address of the string constant .LC<index>
+};
+
+struct IrOperand {
+    IrOperandKind kind;
+    bool is_float;
+    int vreg;
+    long long imm;
+    double fimm;
+    const char *name;
+
+    bool is_vreg() const { return kind == IR_VREG; }
+    bool is_const() const { return kind == IR_IMM || kind == IR_FIMM; }
+    bool same(const IrOperand &o) const;
+};
+
+IrOperand ir_none();
+IrOperand ir_vreg(int vreg, bool is_float);
+IrOperand ir_imm(long long value);
+IrOperand ir_fimm(double value);
+IrOperand ir_global(const char *name, bool is_float);
+IrOperand ir_string(int index);
+
+enum IrOpcode {
+    IR_MOV,                                          // dst = a
+    IR_ADD, IR_SUB, IR_MUL, IR_DIV, IR_MOD,          // dst = a op b, Int
+    IR_AND, IR_OR, IR_XOR,                           // dst = a op b, Int and Bool
+    IR_FADD, IR_FSUB, IR_FMUL, IR_FDIV,              // dst = a op b, Float
+    IR_NEG, IR_NOT, IR_FNEG,                         // dst = op a
+    IR_I2F,                                          // dst = (Float) a
+    IR_LT, IR_LE, IR_EQ, IR_NE, IR_GE, IR_GT,        // dst = a cmp b, Int or Float operands
+    IR_CALL,                                         // dst = callee(args)
+    IR_TAILCALL,                                     // return callee(args), in place of this frame
+    IR_JMP,                                          // goto target
+    IR_BR,                                           // if a goto target else goto target2
+    IR_RET,                                          // return a
+    // packed Float vectors of IrFunction::lanes doubles
+    IR_VPACK,                                        // dst = {args[0], args[1], ...}
+    IR_VFADD, IR_VFSUB, IR_VFMUL, IR_VFDIV,          // dst = a op b, lane by lane
+    IR_VLANE,                                        // dst = lane b of a
+    IR_VEND                                          // no packed value is live past here
+};
+
+struct IrInstr {
+    IrOpcode op;
+    IrOperand dst;
+    IrOperand a;
+    IrOperand b;
+    vector<IrOperand> args;   // IR_CALL, IR_TAILCALL, IR_VPACK
+    const char *callee;       // IR_CALL, IR_TAILCALL
+    int target;               // IR_JMP, IR_BR
+    int target2;              // IR_BR
+
+    bool is_terminator() const { return op == IR_JMP || op == IR_BR || op == IR_RET || op == IR_TAILCALL; }
+    bool has_dst() const { return dst.kind == IR_VREG; }
+    bool is_vector() const { return op >= IR_VPACK; }
+};
+
+struct IrBlock {
+    int id;
+    vector<IrInstr> instrs;
+    vector<int> succs;
+    vector<int> preds;
+};
+
+struct IrFunction {
+    const char *name;
+    bool is_main;
+    vector<IrOperand> params;
+    vector<IrBlock> blocks;      // blocks[0] is the entry, blocks[i].id == i
+    vector<bool> vreg_is_float;
+    vector<bool> vreg_is_packed; // a Float vector, always in a register
+    int lanes;                   // doubles in a packed vreg
+
+    IrFunction() : name(NULL), is_main(false), lanes(1) {}
+    int new_vreg(bool is_float);
+    int new_packed_vreg();
+    int new_block();
+    int vreg_count() const { return vreg_is_float.size(); }
+};
+
+// instruction constructors
+IrInstr ir_mov(IrOperand dst, IrOperand a);
+IrInstr ir_unary(IrOpcode op, IrOperand dst, IrOperand a);
+IrInstr ir_binary(IrOpcode op, IrOperand dst, IrOperand a, IrOperand b);
+IrInstr ir_call(IrOperand dst, const char *callee, const vector<IrOperand> &args);
+IrInstr ir_jmp(int target);
+IrInstr ir_br(IrOperand cond, int target, int target2);
+IrInstr ir_ret(IrOperand a);
+IrInstr ir_pack(IrOperand dst, const vector<IrOperand> &lanes);
+IrInstr ir_lane(IrOperand dst, IrOperand a, int lane);
+IrInstr ir_vend();
+
+// operands an instruction reads
+void ir_uses(const IrInstr &instr, vector<IrOperand> &uses);
+
+// rebuild succs/preds from the terminators
+void ir_build_cfg(IrFunction &fn);
+
+// drop the blocks the entry cannot reach, renumbering the rest in order
+void ir_remove_unreachable(IrFunction &fn);
+
+// turn `return f(...)` into tail calls, and self tail calls into a jump
+// back to the entry block
+void ir_tail_calls(IrFunction &fn);
+
+// live-in / live-out vreg sets of every block
+struct IrLiveness {
+    vector<vector<bool> > live_in;
+    vector<vector<bool> > live_out;
+};
+void ir_liveness(const IrFunction &fn, IrLiveness &live);
+
+//
+// Register allocation.
+//
+// Linear scan over live intervals on the block order.  A vreg gets a
+// register of its class or a stack slot; stack slots are themselves
+// handed out by interval so dead slots are reused.  When registers
+// run out, the value used least, with uses inside loops counting
+// for more, goes to the stack, so induction variables stay in
+// registers for the whole loop.  Values live across a call prefer
+// the registers a call preserves.
+//
+struct IrRegPool {
+    int num;                  // allocatable registers, indices 0..num-1
+    bool survives_calls;      // false: an interval that spans a call is kept on the stack
+    int preserved;            // registers 0..preserved-1 need no save around a call
+};
+
+struct IrLocation {
+    bool in_reg;
+    int reg;                  // index into the pool of the vreg's class
+    int slot;                 // 0-based stack slot
+};
+
+struct IrAllocation {
+    vector<IrLocation> loc;   // per vreg
+    int slot_count;
+};
+
+void ir_allocate(const IrFunction &fn, const IrRegPool &int_pool, const IrRegPool &float_pool,
+                 bool stack_only, IrAllocation &alloc);
+
+void ir_dump(const IrFunction &fn, ostream &s);
+
+// optimisation passes for -O (cgen_opt.cc); ir_optimize runs them in order
+void ir_constant_propagation(IrFunction &fn);
+void ir_common_subexpressions(IrFunction &fn);
+void ir_hoist_invariants(IrFunction &fn);
+void ir_dead_code(IrFunction &fn);
+// run counted Float loops lanes iterations at a time in packed registers
+void ir_vectorize(IrFunction &fn, int lanes);
+// repeat the body of counted loops factor times per iteration
+void ir_unroll(IrFunction &fn, int factor);
+void ir_optimize(IrFunction &fn);
+// inline calls to functions of at most threshold instructions, whole program
+void ir_inline(vector<IrFunction> &program, int threshold);
+
+#endif
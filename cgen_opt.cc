@@ -0,0 +1,1237 @@
+//**************************************************************
+//
+// IR optimisation passes, run on every function under -O.
+//
+//**************************************************************
+
+#include "cgen_ir.h"
+#include <string.h>
+#include <algorithm>
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////
+//
+//    Constant folding and propagation
+//
+//    A forward dataflow over the blocks tracks, for every vreg,
+//    whether it holds a known constant on entry to each
+//    instruction.  Uses of such vregs are replaced by immediates,
+//    instructions whose operands are all constant are folded into
+//    a mov, and branches on a constant become jumps.
+//
+//////////////////////////////////////////////////////////////////
+
+enum ConstState {
+    CONST_UNKNOWN,   // no definition reaches yet
+    CONST_VALUE,     // always the same constant
+    CONST_VARYING    // not a constant
+};
+
+struct ConstValue {
+    ConstState state;
+    IrOperand value;
+};
+
+typedef vector<ConstValue> ConstEnv;
+
+static ConstValue make_const(ConstState state) {
+    ConstValue c;
+    c.state = state;
+    c.value = ir_none();
+    return c;
+}
+
+static void meet(ConstValue &into, const ConstValue &from) {
+    if (from.state == CONST_UNKNOWN || into.state == CONST_VARYING) return;
+    if (into.state == CONST_UNKNOWN) into = from;
+    else if (from.state == CONST_VARYING || !into.value.same(from.value)) into = make_const(CONST_VARYING);
+}
+
+// the constant an operand holds in env, or IR_NONE
+static IrOperand const_of(const IrOperand &o, const ConstEnv &env) {
+    if (o.is_const()) return o;
+    if (o.is_vreg() && env[o.vreg].state == CONST_VALUE) return env[o.vreg].value;
+    return ir_none();
+}
+
+static bool compare(IrOpcode op, int c) {
+    switch (op) {
+        case IR_LT: return c < 0;
+        case IR_LE: return c <= 0;
+        case IR_EQ: return c == 0;
+        case IR_NE: return c != 0;
+        case IR_GE: return c >= 0;
+        case IR_GT: return c > 0;
+        default: return false;
+    }
+}
+
+// evaluate instr on constant operands; false if it cannot be folded
+static bool fold(const IrInstr &instr, const IrOperand &a, const IrOperand &b, IrOperand &res) {
+    // wrap around like the hardware does
+    unsigned long long x = a.imm, y = b.imm;
+    switch (instr.op) {
+        case IR_MOV:
+            res = a;
+            return a.kind != IR_NONE;
+        case IR_ADD: res = ir_imm(x + y); return true;
+        case IR_SUB: res = ir_imm(x - y); return true;
+        case IR_MUL: res = ir_imm(x * y); return true;
+        case IR_DIV:
+        case IR_MOD:
+            // leave the runtime fault of idivq in place
+            if (b.imm == 0 || (b.imm == -1 && a.imm == (long long) (1ULL << 63))) return false;
+            res = ir_imm(instr.op == IR_DIV ? a.imm / b.imm : a.imm % b.imm);
+            return true;
+        case IR_AND: res = ir_imm(x & y); return true;
+        case IR_OR: res = ir_imm(x | y); return true;
+        case IR_XOR: res = ir_imm(x ^ y); return true;
+        case IR_FADD: res = ir_fimm(a.fimm + b.fimm); return true;
+        case IR_FSUB: res = ir_fimm(a.fimm - b.fimm); return true;
+        case IR_FMUL: res = ir_fimm(a.fimm * b.fimm); return true;
+        case IR_FDIV: res = ir_fimm(a.fimm / b.fimm); return true;
+        case IR_NEG: res = ir_imm(0 - x); return true;
+        case IR_NOT: res = ir_imm(~x); return true;
+        case IR_FNEG: res = ir_fimm(-a.fimm); return true;
+        case IR_I2F: res = ir_fimm((double) a.imm); return true;
+        case IR_LT:
+        case IR_LE:
+        case IR_EQ:
+        case IR_NE:
+        case IR_GE:
+        case IR_GT: {
+            int c;
+            if (a.is_float) {
+                // unordered compares false, except for !=
+                if (a.fimm != a.fimm || b.fimm != b.fimm) {
+                    res = ir_imm(instr.op == IR_NE);
+                    return true;
+                }
+                c = a.fimm < b.fimm ? -1 : (a.fimm > b.fimm ? 1 : 0);
+            }
+            else c = a.imm < b.imm ? -1 : (a.imm > b.imm ? 1 : 0);
+            res = ir_imm(compare(instr.op, c));
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// what instr leaves in its dst, given the constants before it
+static ConstValue evaluate(const IrInstr &instr, const ConstEnv &env) {
+    if (instr.op == IR_CALL) return make_const(CONST_VARYING);
+    IrOperand a = const_of(instr.a, env);
+    IrOperand b = const_of(instr.b, env);
+    bool all_const = a.kind != IR_NONE && (instr.b.kind == IR_NONE || b.kind != IR_NONE);
+    IrOperand res;
+    if (all_const && fold(instr, a, b, res)) {
+        ConstValue c = make_const(CONST_VALUE);
+        c.value = res;
+        return c;
+    }
+    // a vreg read before any definition reaches it
+    if (instr.op == IR_MOV && instr.a.is_vreg() && env[instr.a.vreg].state == CONST_UNKNOWN)
+        return make_const(CONST_UNKNOWN);
+    return make_const(CONST_VARYING);
+}
+
+static void transfer(const IrInstr &instr, ConstEnv &env) {
+    if (instr.has_dst()) env[instr.dst.vreg] = evaluate(instr, env);
+}
+
+static void replace_use(IrOperand &o, const ConstEnv &env) {
+    IrOperand c = const_of(o, env);
+    if (o.is_vreg() && c.kind != IR_NONE) o = c;
+}
+
+void ir_constant_propagation(IrFunction &fn) {
+    int nblocks = fn.blocks.size();
+    int nvregs = fn.vreg_count();
+    vector<ConstEnv> in(nblocks, ConstEnv(nvregs, make_const(CONST_UNKNOWN)));
+    vector<bool> visited(nblocks, false);
+    // parameters arrive with unknown values
+    for (unsigned int p = 0; p < fn.params.size(); ++p)
+        in[0][fn.params[p].vreg] = make_const(CONST_VARYING);
+    visited[0] = true;
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int b = 0; b < nblocks; ++b) {
+            if (!visited[b]) continue;
+            ConstEnv env = in[b];
+            for (unsigned int i = 0; i < fn.blocks[b].instrs.size(); ++i)
+                transfer(fn.blocks[b].instrs[i], env);
+            const vector<int> &succs = fn.blocks[b].succs;
+            for (unsigned int s = 0; s < succs.size(); ++s) {
+                ConstEnv merged = in[succs[s]];
+                for (int v = 0; v < nvregs; ++v) meet(merged[v], env[v]);
+                bool differs = !visited[succs[s]];
+                for (int v = 0; v < nvregs && !differs; ++v)
+                    differs = merged[v].state != in[succs[s]][v].state ||
+                              (merged[v].state == CONST_VALUE && !merged[v].value.same(in[succs[s]][v].value));
+                if (differs) {
+                    in[succs[s]] = merged;
+                    visited[succs[s]] = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // rewrite with the constants known before each instruction
+    bool branch_folded = false;
+    for (int b = 0; b < nblocks; ++b) {
+        if (!visited[b]) continue;
+        ConstEnv env = in[b];
+        vector<IrInstr> &instrs = fn.blocks[b].instrs;
+        for (unsigned int i = 0; i < instrs.size(); ++i) {
+            IrInstr &instr = instrs[i];
+            ConstValue result = make_const(CONST_VARYING);
+            if (instr.has_dst()) result = evaluate(instr, env);
+            replace_use(instr.a, env);
+            replace_use(instr.b, env);
+            for (unsigned int a = 0; a < instr.args.size(); ++a) replace_use(instr.args[a], env);
+            if (result.state == CONST_VALUE) instr = ir_mov(instr.dst, result.value);
+            if (instr.op == IR_BR && instr.a.kind == IR_IMM) {
+                instr = ir_jmp(instr.a.imm ? instr.target : instr.target2);
+                branch_folded = true;
+            }
+            if (instr.has_dst()) env[instr.dst.vreg] = result;
+        }
+    }
+    if (branch_folded) ir_build_cfg(fn);
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    Common subexpressions
+//
+//    Local value numbering over each block.  Copies are followed
+//    back to their source, so operands are compared by the value
+//    they carry, and an instruction that recomputes an available
+//    expression becomes a copy of the vreg that holds it.  A load
+//    of a global is an expression too, and a store makes the
+//    stored value available to the loads after it.  Defining a
+//    vreg forgets everything that read it or was held in it; a
+//    store forgets the loads of that global, and a call the loads
+//    of every global.
+//
+//////////////////////////////////////////////////////////////////
+
+struct AvailableExpr {
+    IrOpcode op;
+    IrOperand a;
+    IrOperand b;
+    int holder;      // vreg that has the value
+};
+
+static bool commutative(IrOpcode op) {
+    switch (op) {
+        case IR_ADD:
+        case IR_MUL:
+        case IR_AND:
+        case IR_OR:
+        case IR_XOR:
+        case IR_FADD:
+        case IR_FMUL:
+        case IR_EQ:
+        case IR_NE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// whether instr computes a value worth looking up
+static bool is_expression(const IrInstr &instr) {
+    if (!instr.has_dst() || instr.op == IR_CALL) return false;
+    return instr.op != IR_MOV || instr.a.kind == IR_GLOBAL;
+}
+
+static int find_available(const vector<AvailableExpr> &avail, const IrInstr &instr) {
+    for (unsigned int e = 0; e < avail.size(); ++e) {
+        const AvailableExpr &expr = avail[e];
+        if (expr.op != instr.op) continue;
+        if (expr.a.same(instr.a) && expr.b.same(instr.b)) return expr.holder;
+        if (commutative(expr.op) && expr.a.same(instr.b) && expr.b.same(instr.a)) return expr.holder;
+    }
+    return -1;
+}
+
+// drop what depends on x, which is about to change
+static void forget(vector<AvailableExpr> &avail, vector<int> &copy_of, const IrOperand &x) {
+    for (unsigned int e = 0; e < avail.size(); ++e)
+        if (avail[e].a.same(x) || avail[e].b.same(x) || (x.is_vreg() && avail[e].holder == x.vreg)) {
+            avail.erase(avail.begin() + e);
+            --e;
+        }
+    if (!x.is_vreg()) return;
+    copy_of[x.vreg] = -1;
+    for (unsigned int v = 0; v < copy_of.size(); ++v)
+        if (copy_of[v] == x.vreg) copy_of[v] = -1;
+}
+
+static void forget_globals(vector<AvailableExpr> &avail) {
+    for (unsigned int e = 0; e < avail.size(); ++e)
+        if (avail[e].a.kind == IR_GLOBAL || avail[e].b.kind == IR_GLOBAL) {
+            avail.erase(avail.begin() + e);
+            --e;
+        }
+}
+
+static void use_source(IrOperand &o, const vector<int> &copy_of) {
+    if (o.is_vreg() && copy_of[o.vreg] >= 0) o = ir_vreg(copy_of[o.vreg], o.is_float);
+}
+
+void ir_common_subexpressions(IrFunction &fn) {
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b) {
+        vector<AvailableExpr> avail;
+        vector<int> copy_of(fn.vreg_count(), -1);
+        vector<IrInstr> &instrs = fn.blocks[b].instrs;
+        for (unsigned int i = 0; i < instrs.size(); ++i) {
+            IrInstr &instr = instrs[i];
+            use_source(instr.a, copy_of);
+            use_source(instr.b, copy_of);
+            for (unsigned int a = 0; a < instr.args.size(); ++a) use_source(instr.args[a], copy_of);
+
+            bool lookup = is_expression(instr);
+            int holder = lookup ? find_available(avail, instr) : -1;
+            if (holder >= 0) instr = ir_mov(instr.dst, ir_vreg(holder, instr.dst.is_float));
+
+            if (instr.has_dst()) forget(avail, copy_of, instr.dst);
+            if (instr.dst.kind == IR_GLOBAL) forget(avail, copy_of, instr.dst);
+            if (instr.op == IR_CALL) forget_globals(avail);
+
+            if (instr.op == IR_MOV && instr.has_dst() && instr.a.is_vreg() && instr.a.vreg != instr.dst.vreg)
+                copy_of[instr.dst.vreg] = instr.a.vreg;
+            else if (lookup && holder < 0 && !instr.a.same(instr.dst) && !instr.b.same(instr.dst)) {
+                AvailableExpr expr = {instr.op, instr.a, instr.b, instr.dst.vreg};
+                avail.push_back(expr);
+            }
+            // the stored value is what the next load would read
+            if (instr.dst.kind == IR_GLOBAL && instr.op == IR_MOV && instr.a.is_vreg()) {
+                AvailableExpr expr = {IR_MOV, instr.dst, ir_none(), instr.a.vreg};
+                avail.push_back(expr);
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    Loops
+//
+//    Natural loops are found from the back edges of the dominator
+//    tree: an edge t -> h where h dominates t.  The loops sharing a
+//    header are merged into one, and the list comes innermost
+//    (smallest) first.
+//
+//////////////////////////////////////////////////////////////////
+
+struct IrLoop {
+    int header;
+    vector<bool> body;      // per block
+    vector<int> latches;    // sources of the back edges
+};
+
+static void dominators(const IrFunction &fn, vector<vector<bool> > &dom) {
+    int nblocks = fn.blocks.size();
+    // blocks nothing reaches dominate nothing
+    vector<bool> reached(nblocks, false);
+    vector<int> work(1, 0);
+    reached[0] = true;
+    while (!work.empty()) {
+        int b = work.back();
+        work.pop_back();
+        for (unsigned int s = 0; s < fn.blocks[b].succs.size(); ++s)
+            if (!reached[fn.blocks[b].succs[s]]) {
+                reached[fn.blocks[b].succs[s]] = true;
+                work.push_back(fn.blocks[b].succs[s]);
+            }
+    }
+    dom.assign(nblocks, vector<bool>(nblocks, false));
+    for (int b = 0; b < nblocks; ++b)
+        if (reached[b]) dom[b] = reached;
+    dom[0].assign(nblocks, false);
+    dom[0][0] = true;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int b = 1; b < nblocks; ++b) {
+            if (!reached[b]) continue;
+            vector<bool> d = reached;
+            const vector<int> &preds = fn.blocks[b].preds;
+            for (unsigned int p = 0; p < preds.size(); ++p)
+                if (reached[preds[p]])
+                    for (int x = 0; x < nblocks; ++x) d[x] = d[x] && dom[preds[p]][x];
+            d[b] = true;
+            if (d != dom[b]) {
+                dom[b] = d;
+                changed = true;
+            }
+        }
+    }
+}
+
+static bool smaller_loop(const IrLoop &x, const IrLoop &y) {
+    return count(x.body.begin(), x.body.end(), true) < count(y.body.begin(), y.body.end(), true);
+}
+
+static void find_loops(const IrFunction &fn, vector<IrLoop> &loops) {
+    int nblocks = fn.blocks.size();
+    vector<vector<bool> > dom;
+    dominators(fn, dom);
+    loops.clear();
+    vector<int> loop_of(nblocks, -1);
+    for (int t = 0; t < nblocks; ++t)
+        for (unsigned int s = 0; s < fn.blocks[t].succs.size(); ++s) {
+            int h = fn.blocks[t].succs[s];
+            if (!dom[t][h]) continue;
+            if (loop_of[h] < 0) {
+                loop_of[h] = loops.size();
+                IrLoop loop;
+                loop.header = h;
+                loop.body.assign(nblocks, false);
+                loop.body[h] = true;
+                loops.push_back(loop);
+            }
+            IrLoop &loop = loops[loop_of[h]];
+            loop.latches.push_back(t);
+            // everything that reaches t without passing h
+            vector<int> work;
+            if (!loop.body[t]) {
+                loop.body[t] = true;
+                work.push_back(t);
+            }
+            while (!work.empty()) {
+                int b = work.back();
+                work.pop_back();
+                for (unsigned int p = 0; p < fn.blocks[b].preds.size(); ++p) {
+                    int pred = fn.blocks[b].preds[p];
+                    if (!loop.body[pred]) {
+                        loop.body[pred] = true;
+                        work.push_back(pred);
+                    }
+                }
+            }
+        }
+    stable_sort(loops.begin(), loops.end(), smaller_loop);
+}
+
+// the block ahead of the loop that jumps to its header, made if needed
+static int preheader(IrFunction &fn, const IrLoop &loop) {
+    const vector<int> &preds = fn.blocks[loop.header].preds;
+    vector<int> outside;
+    for (unsigned int p = 0; p < preds.size(); ++p)
+        if (!loop.body[preds[p]]) outside.push_back(preds[p]);
+    if (outside.size() == 1 && fn.blocks[outside[0]].instrs.back().op == IR_JMP) return outside[0];
+
+    int pre = fn.new_block();
+    fn.blocks[pre].instrs.push_back(ir_jmp(loop.header));
+    for (unsigned int p = 0; p < outside.size(); ++p) {
+        IrInstr &last = fn.blocks[outside[p]].instrs.back();
+        if (last.target == loop.header) last.target = pre;
+        if (last.op == IR_BR && last.target2 == loop.header) last.target2 = pre;
+    }
+    ir_build_cfg(fn);
+    return pre;
+}
+
+// put instr in front of the terminator of block b
+static void insert_before_terminator(IrBlock &block, const IrInstr &instr) {
+    block.instrs.insert(block.instrs.end() - 1, instr);
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    Loop-invariant code motion
+//
+//    An instruction of a loop moves to the preheader when it cannot
+//    fault, reads only constants, vregs the loop never assigns and
+//    globals it never stores to (nor any call it makes), and its dst
+//    is assigned only there and not read on entry to the header.
+//    The last condition keeps every path through the loop, and
+//    every path out of it, seeing the same value.
+//
+//////////////////////////////////////////////////////////////////
+
+static bool hoistable_op(const IrInstr &instr) {
+    switch (instr.op) {
+        case IR_CALL:
+        case IR_TAILCALL:
+        case IR_JMP:
+        case IR_BR:
+        case IR_RET:
+            return false;
+        case IR_DIV:
+        case IR_MOD:
+            // moved ahead of its guard, idivq could fault
+            return instr.b.kind == IR_IMM && instr.b.imm != 0 && instr.b.imm != -1;
+        default:
+            return instr.has_dst();
+    }
+}
+
+static bool hoist_invariants(IrFunction &fn, const IrLoop &loop) {
+    // a loop entered at the start of the function has no preheader
+    if (loop.header == 0) return false;
+    int nblocks = fn.blocks.size();
+    vector<int> defs(fn.vreg_count(), 0);
+    vector<const char *> stored;
+    bool has_call = false;
+    for (int b = 0; b < nblocks; ++b) {
+        if (!loop.body[b]) continue;
+        for (unsigned int i = 0; i < fn.blocks[b].instrs.size(); ++i) {
+            const IrInstr &instr = fn.blocks[b].instrs[i];
+            if (instr.has_dst()) ++defs[instr.dst.vreg];
+            if (instr.dst.kind == IR_GLOBAL) stored.push_back(instr.dst.name);
+            if (instr.op == IR_CALL) has_call = true;
+        }
+    }
+    IrLiveness live;
+    ir_liveness(fn, live);
+    const vector<bool> &live_in = live.live_in[loop.header];
+
+    vector<IrInstr> hoisted;
+    vector<IrOperand> uses;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int b = 0; b < nblocks; ++b) {
+            if (!loop.body[b]) continue;
+            vector<IrInstr> &instrs = fn.blocks[b].instrs;
+            for (unsigned int i = 0; i < instrs.size(); ++i) {
+                const IrInstr &instr = instrs[i];
+                if (!hoistable_op(instr) || defs[instr.dst.vreg] != 1 || live_in[instr.dst.vreg]) continue;
+                ir_uses(instr, uses);
+                bool invariant = true;
+                for (unsigned int u = 0; u < uses.size() && invariant; ++u) {
+                    if (uses[u].is_vreg()) invariant = defs[uses[u].vreg] == 0;
+                    else if (uses[u].kind == IR_GLOBAL) {
+                        invariant = !has_call;
+                        for (unsigned int g = 0; g < stored.size() && invariant; ++g)
+                            invariant = strcmp(stored[g], uses[u].name) != 0;
+                    }
+                }
+                if (!invariant) continue;
+                --defs[instr.dst.vreg];
+                hoisted.push_back(instr);
+                instrs.erase(instrs.begin() + i);
+                --i;
+                changed = true;
+            }
+        }
+    }
+    if (hoisted.empty()) return false;
+    int pre = preheader(fn, loop);
+    for (unsigned int h = 0; h < hoisted.size(); ++h) insert_before_terminator(fn.blocks[pre], hoisted[h]);
+    return true;
+}
+
+void ir_hoist_invariants(IrFunction &fn) {
+    vector<IrLoop> loops;
+    find_loops(fn, loops);
+    for (unsigned int l = 0; l < loops.size(); ++l) {
+        unsigned int nblocks = fn.blocks.size();
+        if (!hoist_invariants(fn, loops[l]) || fn.blocks.size() == nblocks) continue;
+        // a new preheader belongs to the loops around this one
+        for (unsigned int k = l + 1; k < loops.size(); ++k)
+            loops[k].body.push_back(loops[k].body[loops[l].header]);
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    Dead code and control flow cleanup
+//
+//    An instruction whose vreg result is never read, and which has
+//    no effect besides, is deleted; liveness is run again until
+//    nothing more goes.  Jumps to blocks that only jump are sent on
+//    to the final target, so an if with an empty else branches
+//    straight to the join, a branch whose arms meet becomes a jump,
+//    and a block jumped to from just one place is merged into it.
+//    Blocks left unreachable are dropped.
+//
+//////////////////////////////////////////////////////////////////
+
+static bool removable(const IrInstr &instr) {
+    switch (instr.op) {
+        case IR_CALL:
+        case IR_TAILCALL:
+        case IR_JMP:
+        case IR_BR:
+        case IR_RET:
+            return false;
+        case IR_DIV:
+        case IR_MOD:
+            // keep the fault of idivq
+            return instr.b.kind == IR_IMM && instr.b.imm != 0 && instr.b.imm != -1;
+        default:
+            return instr.has_dst();
+    }
+}
+
+static bool remove_dead_instrs(IrFunction &fn) {
+    IrLiveness live;
+    ir_liveness(fn, live);
+    vector<IrOperand> uses;
+    bool changed = false;
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b) {
+        vector<IrInstr> &instrs = fn.blocks[b].instrs;
+        vector<bool> alive = live.live_out[b];
+        // walk backwards, tracking what is read later on
+        for (int i = instrs.size() - 1; i >= 0; --i) {
+            const IrInstr &instr = instrs[i];
+            bool self_move = instr.op == IR_MOV && instr.a.is_vreg() && instr.has_dst() && instr.a.vreg == instr.dst.vreg;
+            if (removable(instr) && (!alive[instr.dst.vreg] || self_move)) {
+                instrs.erase(instrs.begin() + i);
+                changed = true;
+                continue;
+            }
+            if (instr.has_dst()) alive[instr.dst.vreg] = false;
+            ir_uses(instr, uses);
+            for (unsigned int u = 0; u < uses.size(); ++u)
+                if (uses[u].is_vreg()) alive[uses[u].vreg] = true;
+        }
+    }
+    return changed;
+}
+
+// where a jump to block b ends up, skipping blocks that only jump
+static int final_target(const IrFunction &fn, int b) {
+    for (unsigned int steps = 0; steps < fn.blocks.size(); ++steps) {
+        const vector<IrInstr> &instrs = fn.blocks[b].instrs;
+        if (instrs.size() != 1 || instrs[0].op != IR_JMP) break;
+        b = instrs[0].target;
+    }
+    return b;
+}
+
+static void thread_jumps(IrFunction &fn) {
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b) {
+        if (fn.blocks[b].instrs.empty()) continue;
+        IrInstr &last = fn.blocks[b].instrs.back();
+        if (last.op != IR_JMP && last.op != IR_BR) continue;
+        int target = final_target(fn, last.target);
+        int target2 = last.op == IR_BR ? final_target(fn, last.target2) : -1;
+        last.target = target;
+        last.target2 = target2;
+        if (last.op == IR_BR && target == target2) last = ir_jmp(target);
+    }
+    ir_build_cfg(fn);
+}
+
+// append a block to its only predecessor when that just jumps to it
+static void merge_blocks(IrFunction &fn) {
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b) {
+        IrBlock &block = fn.blocks[b];
+        while (!block.instrs.empty() && block.instrs.back().op == IR_JMP) {
+            int next = block.instrs.back().target;
+            if (next == 0 || next == (int) b || fn.blocks[next].preds.size() != 1) break;
+            block.instrs.pop_back();
+            block.instrs.insert(block.instrs.end(), fn.blocks[next].instrs.begin(), fn.blocks[next].instrs.end());
+            // leave next unreachable, jumping to itself
+            fn.blocks[next].instrs.assign(1, ir_jmp(next));
+            ir_build_cfg(fn);
+        }
+    }
+}
+
+void ir_dead_code(IrFunction &fn) {
+    while (remove_dead_instrs(fn)) {}
+    thread_jumps(fn);
+    // the blocks jumped around would still count as predecessors
+    ir_remove_unreachable(fn);
+    merge_blocks(fn);
+    ir_remove_unreachable(fn);
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    Vectorisation
+//
+//    A counted loop whose body is a single block of Float arithmetic
+//    on the index and on invariants gets a packed copy that runs
+//    `lanes` iterations at a time:
+//
+//        pre -> VP -> VH -> VB -> VH,   VH -> VX -> H -> B -> H
+//
+//    VP packs the invariants, VH checks that `lanes` iterations are
+//    left, and VB computes every Int value once per lane, converts
+//    the lanes to Float and does the Float arithmetic in packed
+//    registers.  VX ends the use of the packed registers, and the
+//    original loop runs what is left.  Values summed (or multiplied)
+//    across iterations are folded in lane by lane, in iteration
+//    order, so the result is bit for bit that of the scalar loop.
+//
+//////////////////////////////////////////////////////////////////
+
+#define MAX_PACKED_VREGS 6   // live at once; leave float registers for the scalar values
+
+enum LaneKind {
+    LANE_NONE,       // not defined in the loop
+    LANE_INT,        // Int value, computed per lane
+    LANE_PACKED,     // Float value, one per lane in a packed register
+    LANE_REDUCED     // Float carried around the loop by + - or *
+};
+
+struct CountedLoop {
+    int header;
+    int body;
+    int exit;
+    IrOperand index;
+    IrOpcode cond;         // index cond bound, IR_LT or IR_LE
+    IrOperand bound;
+    unsigned int update;   // first instruction of the index update
+};
+
+static IrOpcode packed_opcode(IrOpcode op) {
+    switch (op) {
+        case IR_FADD: return IR_VFADD;
+        case IR_FSUB: return IR_VFSUB;
+        case IR_FMUL: return IR_VFMUL;
+        case IR_FDIV: return IR_VFDIV;
+        default: return IR_MOV;
+    }
+}
+
+static bool is_index_update(const vector<IrInstr> &instrs, unsigned int i, const IrOperand &index) {
+    const IrInstr &add = instrs[i];
+    if (add.op != IR_ADD || !add.a.same(index) || add.b.kind != IR_IMM || add.b.imm != 1) return false;
+    if (add.dst.same(index)) return i + 2 == instrs.size();
+    const IrInstr &mov = instrs[i + 1];
+    return i + 3 == instrs.size() && mov.op == IR_MOV && mov.dst.same(index) && mov.a.same(add.dst);
+}
+
+// `for (; index < bound; index = index + 1)` around a single block
+static bool match_counted_loop(const IrFunction &fn, const IrLoop &loop, CountedLoop &cl) {
+    if (loop.latches.size() != 1 || count(loop.body.begin(), loop.body.end(), true) != 2) return false;
+    cl.header = loop.header;
+    cl.body = loop.latches[0];
+    // the entry block has no preheader to go in front of it
+    if (cl.header == 0) return false;
+    const vector<IrInstr> &head = fn.blocks[cl.header].instrs;
+    const vector<IrInstr> &body = fn.blocks[cl.body].instrs;
+    if (head.size() != 2 || (head[0].op != IR_LT && head[0].op != IR_LE)) return false;
+    if (head[1].op != IR_BR || !head[1].a.same(head[0].dst) || head[1].target != cl.body) return false;
+    cl.exit = head[1].target2;
+    cl.index = head[0].a;
+    cl.cond = head[0].op;
+    cl.bound = head[0].b;
+    if (!cl.index.is_vreg() || cl.index.is_float) return false;
+    if (cl.bound.kind != IR_IMM && !(cl.bound.is_vreg() && !cl.bound.is_float)) return false;
+    if (body.size() < 2 || body.back().op != IR_JMP) return false;
+    cl.update = body.size() - 2;
+    if (!is_index_update(body, cl.update, cl.index)) {
+        cl.update = body.size() - 3;
+        if (body.size() < 3 || !is_index_update(body, cl.update, cl.index)) return false;
+    }
+    // the update is the only write to the index, and nothing writes the bound
+    for (unsigned int i = 0; i < cl.update; ++i) {
+        if (!body[i].has_dst()) continue;
+        if (body[i].dst.same(cl.index) || body[i].dst.same(cl.bound)) return false;
+    }
+    return true;
+}
+
+// whether the index can be checked for `steps` iterations left
+static bool steps_fit(const CountedLoop &cl, int steps) {
+    // the last of them is index + steps - 1
+    const long long int_min = (long long) (1ULL << 63);
+    return cl.bound.kind != IR_IMM || cl.bound.imm >= int_min + steps - 1;
+}
+
+// fill block g with the bound the index is checked against for `steps`
+// iterations left, going on to next, or to skip when that bound wraps
+static IrOperand steps_limit(IrFunction &fn, int g, int next, int skip, const CountedLoop &cl, int steps) {
+    vector<IrInstr> &instrs = fn.blocks[g].instrs;
+    if (cl.bound.kind == IR_IMM) {
+        instrs.push_back(ir_jmp(next));
+        return ir_imm(cl.bound.imm - (steps - 1));
+    }
+    IrOperand limit = ir_vreg(fn.new_vreg(false), false);
+    IrOperand wraps = ir_vreg(fn.new_vreg(false), false);
+    instrs.push_back(ir_binary(IR_SUB, limit, cl.bound, ir_imm(steps - 1)));
+    instrs.push_back(ir_binary(IR_GT, wraps, limit, cl.bound));
+    instrs.push_back(ir_br(wraps, skip, next));
+    return limit;
+}
+
+// an operand the loop never changes
+static bool loop_invariant(const IrOperand &o, const vector<int> &defs) {
+    return o.kind == IR_IMM || o.kind == IR_FIMM || (o.is_vreg() && defs[o.vreg] == 0);
+}
+
+// the Float value of a reduction `r = r op x` the instruction at i starts,
+// and the instruction that writes r back
+static bool match_reduction(const vector<IrInstr> &body, unsigned int i, const IrLiveness &live, int header,
+                            IrOperand &carried, unsigned int &write_back) {
+    const IrInstr &instr = body[i];
+    if (instr.op != IR_FADD && instr.op != IR_FSUB && instr.op != IR_FMUL) return false;
+    write_back = i;
+    if (!instr.dst.same(instr.a) && !instr.dst.same(instr.b)) {
+        if (i + 1 >= body.size() || body[i + 1].op != IR_MOV || !body[i + 1].a.same(instr.dst)) return false;
+        write_back = i + 1;
+    }
+    carried = body[write_back].dst;
+    if (!live.live_in[header][carried.vreg]) return false;
+    // x - r is no reduction
+    return carried.same(instr.a) || (instr.op != IR_FSUB && carried.same(instr.b));
+}
+
+// whether the body of cl can be vectorised; fills in the kind of each vreg
+static bool classify_body(const IrFunction &fn, const CountedLoop &cl, vector<LaneKind> &kind) {
+    const vector<IrInstr> &body = fn.blocks[cl.body].instrs;
+    int nvregs = fn.vreg_count();
+    vector<int> defs(nvregs, 0);
+    for (unsigned int i = 0; i < body.size(); ++i)
+        if (body[i].has_dst()) ++defs[body[i].dst.vreg];
+    const IrInstr &cmp = fn.blocks[cl.header].instrs[0];
+    ++defs[cmp.dst.vreg];
+    IrLiveness live;
+    ir_liveness(fn, live);
+
+    kind.assign(nvregs, LANE_NONE);
+    kind[cl.index.vreg] = LANE_INT;
+    vector<IrOperand> invariants;
+    int arithmetic = 0;
+    // the packed value each vreg names, and where those are live
+    vector<int> value(nvregs, -1), born(nvregs), last(nvregs);
+    for (unsigned int i = 0; i < cl.update; ++i) {
+        const IrInstr &instr = body[i];
+        if (!instr.has_dst() || defs[instr.dst.vreg] != 1) return false;
+        IrOperand carried;
+        unsigned int write_back;
+        if (match_reduction(body, i, live, cl.header, carried, write_back)) {
+            const IrOperand &x = carried.same(instr.a) ? instr.b : instr.a;
+            if (!loop_invariant(x, defs) && !(x.is_vreg() && kind[x.vreg] == LANE_PACKED)) return false;
+            if (x.same(carried) || kind[carried.vreg] != LANE_NONE || defs[carried.vreg] != 1) return false;
+            if (write_back != i && live.live_in[cl.header][instr.dst.vreg]) return false;
+            if (x.is_vreg() && kind[x.vreg] == LANE_PACKED) last[value[x.vreg]] = i;
+            kind[carried.vreg] = LANE_REDUCED;
+            if (write_back != i) kind[instr.dst.vreg] = LANE_REDUCED;
+            i = write_back;
+            continue;
+        }
+        // anything else the loop carries is a recurrence
+        if (live.live_in[cl.header][instr.dst.vreg]) return false;
+        vector<IrOperand> uses;
+        ir_uses(instr, uses);
+        if (!instr.dst.is_float) {
+            switch (instr.op) {
+                case IR_MOV: case IR_ADD: case IR_SUB: case IR_MUL: case IR_DIV: case IR_MOD:
+                case IR_AND: case IR_OR: case IR_XOR: case IR_NEG: case IR_NOT:
+                    break;
+                default:
+                    return false;
+            }
+            for (unsigned int u = 0; u < uses.size(); ++u)
+                if (!loop_invariant(uses[u], defs) && !(uses[u].is_vreg() && kind[uses[u].vreg] == LANE_INT))
+                    return false;
+            kind[instr.dst.vreg] = LANE_INT;
+            continue;
+        }
+        if (instr.op == IR_I2F) {
+            if (!instr.a.is_vreg() || kind[instr.a.vreg] != LANE_INT) return false;
+            kind[instr.dst.vreg] = LANE_PACKED;
+            value[instr.dst.vreg] = instr.dst.vreg;
+            born[instr.dst.vreg] = last[instr.dst.vreg] = i;
+            continue;
+        }
+        if (instr.op == IR_MOV) {
+            // another name for the same packed value
+            if (!instr.a.is_vreg() || kind[instr.a.vreg] != LANE_PACKED) return false;
+            kind[instr.dst.vreg] = LANE_PACKED;
+            value[instr.dst.vreg] = value[instr.a.vreg];
+            continue;
+        }
+        if (packed_opcode(instr.op) == IR_MOV) return false;
+        bool has_lanes = false;
+        for (unsigned int u = 0; u < uses.size(); ++u) {
+            if (uses[u].is_vreg() && kind[uses[u].vreg] == LANE_PACKED) {
+                has_lanes = true;
+                last[value[uses[u].vreg]] = i;
+            }
+            else if (!loop_invariant(uses[u], defs)) return false;
+            else {
+                bool seen = false;
+                for (unsigned int v = 0; v < invariants.size() && !seen; ++v) seen = invariants[v].same(uses[u]);
+                if (!seen) invariants.push_back(uses[u]);
+            }
+        }
+        if (!has_lanes) return false;
+        kind[instr.dst.vreg] = LANE_PACKED;
+        value[instr.dst.vreg] = instr.dst.vreg;
+        born[instr.dst.vreg] = last[instr.dst.vreg] = i;
+        ++arithmetic;
+    }
+    // packing only pays when there is packed arithmetic to do
+    if (arithmetic == 0) return false;
+    for (unsigned int i = 0; i < cl.update; ++i) {
+        int pressure = invariants.size();
+        for (int v = 0; v < nvregs; ++v)
+            if (value[v] == v && born[v] <= (int) i && (int) i <= last[v]) ++pressure;
+        if (pressure > MAX_PACKED_VREGS) return false;
+    }
+    return true;
+}
+
+// the packed vreg holding {o, o, ...}, packed in block pre the first time
+static IrOperand broadcast(IrFunction &fn, int pre, const IrOperand &o, vector<IrOperand> &from,
+                           vector<IrOperand> &to) {
+    for (unsigned int b = 0; b < from.size(); ++b)
+        if (from[b].same(o)) return to[b];
+    IrOperand p = ir_vreg(fn.new_packed_vreg(), true);
+    insert_before_terminator(fn.blocks[pre], ir_pack(p, vector<IrOperand>(fn.lanes, o)));
+    from.push_back(o);
+    to.push_back(p);
+    return p;
+}
+
+static bool vectorize_loop(IrFunction &fn, const IrLoop &loop, int lanes) {
+    CountedLoop cl;
+    vector<LaneKind> kind;
+    if (!match_counted_loop(fn, loop, cl) || !classify_body(fn, cl, kind)) return false;
+    if (!steps_fit(cl, lanes)) return false;
+
+    int pre = preheader(fn, loop);
+    int vp = fn.new_block(), vh = fn.new_block(), vb = fn.new_block(), vx = fn.new_block();
+    fn.blocks[pre].instrs.back().target = vp;
+    fn.lanes = lanes;
+
+    // VP
+    IrOperand limit = steps_limit(fn, vp, vh, vx, cl, lanes);
+
+    // VH
+    IrOperand more = ir_vreg(fn.new_vreg(false), false);
+    fn.blocks[vh].instrs.push_back(ir_binary(cl.cond, more, cl.index, limit));
+    fn.blocks[vh].instrs.push_back(ir_br(more, vb, vx));
+
+    // VB
+    int nvregs = kind.size();
+    vector<vector<IrOperand> > lane_of(lanes, vector<IrOperand>(nvregs));
+    vector<IrOperand> packed_of(nvregs);
+    vector<IrOperand> from, to;
+    vector<IrInstr> &out = fn.blocks[vb].instrs;
+    for (int k = 0; k < lanes; ++k) {
+        lane_of[k][cl.index.vreg] = cl.index;
+        if (k == 0) continue;
+        lane_of[k][cl.index.vreg] = ir_vreg(fn.new_vreg(false), false);
+        out.push_back(ir_binary(IR_ADD, lane_of[k][cl.index.vreg], cl.index, ir_imm(k)));
+    }
+    const vector<IrInstr> body = fn.blocks[cl.body].instrs;
+    for (unsigned int i = 0; i < cl.update; ++i) {
+        const IrInstr &instr = body[i];
+        if (kind[instr.dst.vreg] == LANE_INT) {
+            for (int k = 0; k < lanes; ++k) {
+                IrInstr copy = instr;
+                copy.dst = lane_of[k][instr.dst.vreg] = ir_vreg(fn.new_vreg(false), false);
+                if (copy.a.is_vreg() && kind[copy.a.vreg] == LANE_INT) copy.a = lane_of[k][copy.a.vreg];
+                if (copy.b.is_vreg() && kind[copy.b.vreg] == LANE_INT) copy.b = lane_of[k][copy.b.vreg];
+                out.push_back(copy);
+            }
+        }
+        else if (kind[instr.dst.vreg] == LANE_REDUCED) {
+            // r = r op x, lane after lane
+            const IrInstr &next = body[i + 1];
+            IrOperand carried = instr.dst;
+            if (!instr.dst.same(instr.a) && !instr.dst.same(instr.b)) {
+                carried = next.dst;
+                ++i;
+            }
+            bool first = carried.same(instr.a);
+            const IrOperand &x = first ? instr.b : instr.a;
+            for (int k = 0; k < lanes; ++k) {
+                IrOperand value = x;
+                if (x.is_vreg() && kind[x.vreg] == LANE_PACKED) {
+                    value = ir_vreg(fn.new_vreg(true), true);
+                    out.push_back(ir_lane(value, packed_of[x.vreg], k));
+                }
+                out.push_back(ir_binary(instr.op, carried, first ? carried : value, first ? value : carried));
+            }
+        }
+        else if (instr.op == IR_I2F) {
+            vector<IrOperand> values;
+            for (int k = 0; k < lanes; ++k) {
+                values.push_back(ir_vreg(fn.new_vreg(true), true));
+                out.push_back(ir_unary(IR_I2F, values[k], lane_of[k][instr.a.vreg]));
+            }
+            packed_of[instr.dst.vreg] = ir_vreg(fn.new_packed_vreg(), true);
+            out.push_back(ir_pack(packed_of[instr.dst.vreg], values));
+        }
+        else if (instr.op == IR_MOV) packed_of[instr.dst.vreg] = packed_of[instr.a.vreg];
+        else {
+            IrOperand a = instr.a, b = instr.b;
+            a = a.is_vreg() && kind[a.vreg] == LANE_PACKED ? packed_of[a.vreg] : broadcast(fn, vp, a, from, to);
+            b = b.is_vreg() && kind[b.vreg] == LANE_PACKED ? packed_of[b.vreg] : broadcast(fn, vp, b, from, to);
+            packed_of[instr.dst.vreg] = ir_vreg(fn.new_packed_vreg(), true);
+            out.push_back(ir_binary(packed_opcode(instr.op), packed_of[instr.dst.vreg], a, b));
+        }
+    }
+    out.push_back(ir_binary(IR_ADD, cl.index, cl.index, ir_imm(lanes)));
+    out.push_back(ir_jmp(vh));
+
+    // VX, which also tells ir_unroll the loop after it is a remainder
+    fn.blocks[vx].instrs.push_back(ir_vend());
+    fn.blocks[vx].instrs.push_back(ir_jmp(cl.header));
+    ir_build_cfg(fn);
+    return true;
+}
+
+void ir_vectorize(IrFunction &fn, int lanes) {
+    vector<IrLoop> loops;
+    find_loops(fn, loops);
+    for (unsigned int l = 0; l < loops.size(); ++l) {
+        loops[l].body.resize(fn.blocks.size(), false);
+        vectorize_loop(fn, loops[l], lanes);
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    Unrolling
+//
+//    A counted loop over a single block gets a copy whose body is
+//    that block `factor` times over:
+//
+//        pre -> UP -> UH -> UB -> UH,   UH -> H -> B -> H
+//
+//    UH checks that `factor` iterations are left, and the original
+//    loop runs the rest.  When the index starts at a constant and the
+//    bound is one, the number of iterations is known: the ones left
+//    over are copied once more into a straight block UR, and the
+//    original loop goes away.
+//
+//////////////////////////////////////////////////////////////////
+
+#define MAX_UNROLLED_SIZE 64   // IR instructions in the unrolled body
+
+// append the body of a loop to out, with fresh vregs for the values
+// only that copy uses
+static void append_copy(IrFunction &fn, const vector<IrInstr> &body, const vector<bool> &carried,
+                        vector<IrInstr> &out) {
+    vector<int> name(fn.vreg_count(), -1);
+    for (unsigned int i = 0; i + 1 < body.size(); ++i) {
+        IrInstr copy = body[i];
+        IrOperand *operands[] = {&copy.a, &copy.b};
+        for (int o = 0; o < 2; ++o)
+            if (operands[o]->is_vreg() && name[operands[o]->vreg] >= 0) operands[o]->vreg = name[operands[o]->vreg];
+        for (unsigned int a = 0; a < copy.args.size(); ++a)
+            if (copy.args[a].is_vreg() && name[copy.args[a].vreg] >= 0) copy.args[a].vreg = name[copy.args[a].vreg];
+        if (copy.has_dst() && !carried[copy.dst.vreg]) {
+            int v = copy.dst.vreg;
+            name[v] = fn.vreg_is_packed[v] ? fn.new_packed_vreg() : fn.new_vreg(fn.vreg_is_float[v]);
+            copy.dst.vreg = name[v];
+        }
+        out.push_back(copy);
+    }
+}
+
+static bool unroll_loop(IrFunction &fn, const IrLoop &loop, int factor) {
+    CountedLoop cl;
+    if (!match_counted_loop(fn, loop, cl) || !steps_fit(cl, factor)) return false;
+    const vector<IrInstr> body = fn.blocks[cl.body].instrs;
+    if ((body.size() - 1) * factor > MAX_UNROLLED_SIZE) return false;
+    // what a vector loop leaves is fewer iterations than its lanes
+    const vector<int> &preds = fn.blocks[cl.header].preds;
+    for (unsigned int p = 0; p < preds.size(); ++p)
+        if (fn.blocks[preds[p]].instrs[0].op == IR_VEND) return false;
+    IrLiveness live;
+    ir_liveness(fn, live);
+    const vector<bool> carried = live.live_in[cl.header];
+
+    int pre = preheader(fn, loop);
+    // the number of iterations, when the index starts at a constant
+    bool known = false;
+    unsigned long long trips = 0;
+    const vector<IrInstr> &entry = fn.blocks[pre].instrs;
+    for (int i = entry.size() - 1; i >= 0 && cl.bound.kind == IR_IMM; --i) {
+        if (!entry[i].has_dst() || !entry[i].dst.same(cl.index)) continue;
+        const long long int_max = (long long) (~0ULL >> 1);
+        if (entry[i].op != IR_MOV || entry[i].a.kind != IR_IMM) break;
+        if (cl.cond == IR_LE && cl.bound.imm == int_max) break;
+        long long start = entry[i].a.imm, end = cl.bound.imm + (cl.cond == IR_LE ? 1 : 0);
+        // a loop that never runs is left alone
+        if (start >= end) return false;
+        known = true;
+        trips = (unsigned long long) end - (unsigned long long) start;
+        break;
+    }
+
+    int up = fn.new_block(), uh = fn.new_block(), ub = fn.new_block();
+    int after = cl.header;
+    if (known) after = trips % factor == 0 ? cl.exit : fn.new_block();
+    fn.blocks[pre].instrs.back().target = up;
+
+    // UP
+    IrOperand limit = steps_limit(fn, up, uh, after, cl, factor);
+
+    // UH
+    IrOperand more = ir_vreg(fn.new_vreg(false), false);
+    fn.blocks[uh].instrs.push_back(ir_binary(cl.cond, more, cl.index, limit));
+    fn.blocks[uh].instrs.push_back(ir_br(more, ub, after));
+
+    // UB
+    for (int k = 0; k < factor; ++k) append_copy(fn, body, carried, fn.blocks[ub].instrs);
+    fn.blocks[ub].instrs.push_back(ir_jmp(uh));
+
+    // UR
+    if (after != cl.header && after != cl.exit) {
+        for (unsigned int k = 0; k < trips % factor; ++k) append_copy(fn, body, carried, fn.blocks[after].instrs);
+        fn.blocks[after].instrs.push_back(ir_jmp(cl.exit));
+    }
+    ir_build_cfg(fn);
+    return true;
+}
+
+void ir_unroll(IrFunction &fn, int factor) {
+    if (factor < 2) return;
+    vector<IrLoop> loops;
+    find_loops(fn, loops);
+    bool changed = false;
+    for (unsigned int l = 0; l < loops.size(); ++l) {
+        loops[l].body.resize(fn.blocks.size(), false);
+        if (unroll_loop(fn, loops[l], factor)) changed = true;
+    }
+    // drop the loops whose iterations were all copied, and the jumps
+    // between the new blocks
+    if (changed) ir_dead_code(fn);
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    Inlining
+//
+//    A call to a small function of the program is replaced by a
+//    copy of its blocks.  The callee's vregs, its locals included,
+//    are renamed to fresh vregs of the caller, so the allocator
+//    gives them registers or stack slots for just the stretch they
+//    are live.  The block holding the call is split after it: the
+//    copy is entered with the arguments moved into the parameters,
+//    and every return becomes a mov into the call's dst and a jump
+//    to the rest of the block.  When the call is itself returned at
+//    once, the callee's returns stay returns, so a call the callee
+//    makes in tail position is still one in the caller.
+//
+//////////////////////////////////////////////////////////////////
+
+static int function_size(const IrFunction &fn) {
+    int size = 0;
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b) size += fn.blocks[b].instrs.size();
+    return size;
+}
+
+static bool calls(const IrFunction &fn, const char *callee) {
+    for (unsigned int b = 0; b < fn.blocks.size(); ++b)
+        for (unsigned int i = 0; i < fn.blocks[b].instrs.size(); ++i) {
+            const IrInstr &instr = fn.blocks[b].instrs[i];
+            if (instr.op == IR_CALL && strcmp(instr.callee, callee) == 0) return true;
+        }
+    return false;
+}
+
+// the function worth inlining for a call to name, or NULL
+static const IrFunction *inline_candidate(const vector<IrFunction> &program, const IrFunction &caller,
+                                          const char *name, int threshold) {
+    if (strcmp(name, caller.name) == 0) return NULL;
+    for (unsigned int f = 0; f < program.size(); ++f) {
+        const IrFunction &fn = program[f];
+        if (strcmp(fn.name, name) != 0) continue;
+        if (fn.is_main || function_size(fn) > threshold || calls(fn, fn.name)) return NULL;
+        return &fn;
+    }
+    return NULL;
+}
+
+static IrOperand rename(const IrOperand &o, const vector<int> &vregs) {
+    if (!o.is_vreg()) return o;
+    return ir_vreg(vregs[o.vreg], o.is_float);
+}
+
+// replace the call at blocks[b].instrs[i] by a copy of callee
+static void inline_call(IrFunction &fn, int b, int i, const IrFunction &callee, vector<bool> &copied) {
+    IrInstr call = fn.blocks[b].instrs[i];
+    // the call is in tail position when the block returns its result next
+    const vector<IrInstr> &after = fn.blocks[b].instrs;
+    bool is_tail = i + 2 == (int) after.size() && after[i + 1].op == IR_RET
+        && (after[i + 1].a.kind == IR_NONE || (call.has_dst() && after[i + 1].a.is_vreg() && after[i + 1].a.vreg == call.dst.vreg));
+    bool returns_value = is_tail && after[i + 1].a.kind != IR_NONE;
+    vector<int> vregs(callee.vreg_count());
+    for (int v = 0; v < callee.vreg_count(); ++v) vregs[v] = fn.new_vreg(callee.vreg_is_float[v]);
+    int base = fn.blocks.size();
+    for (unsigned int c = 0; c < callee.blocks.size(); ++c) fn.new_block();
+    int rest = fn.new_block();
+    copied.resize(fn.blocks.size(), true);
+    copied[rest] = false;
+
+    vector<IrInstr> &instrs = fn.blocks[b].instrs;
+    fn.blocks[rest].instrs.assign(instrs.begin() + i + 1, instrs.end());
+    instrs.resize(i);
+    for (unsigned int a = 0; a < call.args.size(); ++a)
+        instrs.push_back(ir_mov(rename(callee.params[a], vregs), call.args[a]));
+    instrs.push_back(ir_jmp(base));
+
+    for (unsigned int c = 0; c < callee.blocks.size(); ++c) {
+        vector<IrInstr> &body = fn.blocks[base + c].instrs;
+        for (unsigned int k = 0; k < callee.blocks[c].instrs.size(); ++k) {
+            IrInstr instr = callee.blocks[c].instrs[k];
+            if (instr.op == IR_RET && is_tail) {
+                body.push_back(ir_ret(returns_value ? rename(instr.a, vregs) : ir_none()));
+                continue;
+            }
+            if (instr.op == IR_RET) {
+                if (call.has_dst() && instr.a.kind != IR_NONE) body.push_back(ir_mov(call.dst, rename(instr.a, vregs)));
+                body.push_back(ir_jmp(rest));
+                continue;
+            }
+            instr.dst = rename(instr.dst, vregs);
+            instr.a = rename(instr.a, vregs);
+            instr.b = rename(instr.b, vregs);
+            for (unsigned int a = 0; a < instr.args.size(); ++a) instr.args[a] = rename(instr.args[a], vregs);
+            if (instr.op == IR_JMP || instr.op == IR_BR) {
+                instr.target += base;
+                instr.target2 += base;
+            }
+            body.push_back(instr);
+        }
+    }
+}
+
+void ir_inline(vector<IrFunction> &program, int threshold) {
+    for (unsigned int f = 0; f < program.size(); ++f) {
+        IrFunction &fn = program[f];
+        // calls inside an inlined copy are left alone, so mutual recursion stops
+        vector<bool> copied(fn.blocks.size(), false);
+        bool changed = false;
+        for (unsigned int b = 0; b < fn.blocks.size(); ++b) {
+            if (copied[b]) continue;
+            for (unsigned int i = 0; i < fn.blocks[b].instrs.size(); ++i) {
+                const IrInstr &instr = fn.blocks[b].instrs[i];
+                if (instr.op != IR_CALL) continue;
+                const IrFunction *callee = inline_candidate(program, fn, instr.callee, threshold);
+                if (callee == NULL) continue;
+                inline_call(fn, b, i, *callee, copied);
+                changed = true;
+                // the rest of the block moved to a new block, scanned later
+                break;
+            }
+        }
+        if (changed) ir_build_cfg(fn);
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+//
+//    Pass pipeline
+//
+//////////////////////////////////////////////////////////////////
+
+void ir_optimize(IrFunction &fn) {
+    ir_constant_propagation(fn);
+    ir_common_subexpressions(fn);
+    ir_hoist_invariants(fn);
+    ir_dead_code(fn);
+}
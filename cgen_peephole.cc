@@ -0,0 +1,172 @@
+//**************************************************************
+//
+// Peephole optimiser, run on every function under -O.
+//
+// To add a pattern, write a rule that looks at the instructions
+// from position i on, rewrites them and returns true when it
+// applies, and list it in the patterns table.  A rule must leave
+// fewer instructions than it found, so the scan always ends.
+//
+//**************************************************************
+
+#include "cgen_peephole.h"
+#include "emit.h"
+#include <string.h>
+
+using namespace std;
+
+static bool is_label_of(const AsmInstr &instr, const AsmOperand &label) {
+    return instr.op == NULL && same_operand(instr.args[0], label);
+}
+
+static bool is_move(const AsmInstr &instr) {
+    return (is_op(instr, MOV) || is_op(instr, MOVSD) || is_op(instr, MOVAPS)) && instr.args.size() == 2;
+}
+
+// give code[i] a new instruction
+static void set_instr(AsmCode &code, unsigned int i, const char *op, const vector<AsmOperand> &args) {
+    code[i].op = op;
+    code[i].args = args;
+}
+
+//
+// Rules
+//
+
+// movq %rax, %rax
+static bool drop_self_move(AsmCode &code, unsigned int i) {
+    if (!is_move(code[i]) || !same_operand(code[i].args[0], code[i].args[1])) return false;
+    code.erase(code.begin() + i);
+    return true;
+}
+
+// movq %rax, -16(%rbp); movq -16(%rbp), %rax
+static bool drop_reload(AsmCode &code, unsigned int i) {
+    if (i + 1 >= code.size()) return false;
+    const AsmInstr &store = code[i], &load = code[i + 1];
+    if (!is_move(store) || !is_op(load, store.op) || load.args.size() != 2) return false;
+    if (!same_operand(load.args[0], store.args[1]) || !same_operand(load.args[1], store.args[0])) return false;
+    // the first move must not change what its source names
+    if (!is_reg(store.args[0]) && !is_reg(store.args[1])) return false;
+    if (reads_reg(store.args[0], store.args[1])) return false;
+    code.erase(code.begin() + i + 1);
+    return true;
+}
+
+// movq x(%rip), %rax; movq x(%rip), %rax
+static bool drop_repeated_move(AsmCode &code, unsigned int i) {
+    if (i + 1 >= code.size() || !is_move(code[i]) || !is_op(code[i + 1], code[i].op)) return false;
+    const vector<AsmOperand> &first = code[i].args, &second = code[i + 1].args;
+    if (second.size() != 2 || !same_operand(first[0], second[0]) || !same_operand(first[1], second[1])) return false;
+    if (reads_reg(first[0], first[1])) return false;
+    code.erase(code.begin() + i + 1);
+    return true;
+}
+
+// pushq %r10; popq %r10
+static bool drop_push_pop(AsmCode &code, unsigned int i) {
+    if (i + 1 >= code.size() || !is_op(code[i], PUSH) || !is_op(code[i + 1], POP)) return false;
+    if (!same_operand(code[i].args[0], code[i + 1].args[0])) return false;
+    code.erase(code.begin() + i, code.begin() + i + 2);
+    return true;
+}
+
+// jmp .POS3; .POS3:
+static bool drop_jump_to_next(AsmCode &code, unsigned int i) {
+    if (!is_op(code[i], JMP) || code[i].args[0].kind != ASM_BLOCK) return false;
+    for (unsigned int k = i + 1; k < code.size() && code[k].op == NULL; ++k)
+        if (is_label_of(code[k], code[i].args[0])) {
+            code.erase(code.begin() + i);
+            return true;
+        }
+    return false;
+}
+
+static const char *INVERSE_JUMPS[][2] = {
+    {JE, JNE}, {JZ, JNZ}, {JL, JGE}, {JLE, JG},
+    {JB, JAE}, {JBE, JA}, {JP, JNP}
+};
+
+static const char *inverse_jump(const AsmInstr &instr) {
+    for (unsigned int j = 0; j < sizeof(INVERSE_JUMPS) / sizeof(INVERSE_JUMPS[0]); ++j) {
+        if (is_op(instr, INVERSE_JUMPS[j][0])) return INVERSE_JUMPS[j][1];
+        if (is_op(instr, INVERSE_JUMPS[j][1])) return INVERSE_JUMPS[j][0];
+    }
+    return NULL;
+}
+
+// jl .POS2; jmp .POS5; .POS2:  =>  jge .POS5; .POS2:
+static bool invert_branch_over_jump(AsmCode &code, unsigned int i) {
+    if (i + 2 >= code.size()) return false;
+    const char *inverse = inverse_jump(code[i]);
+    if (inverse == NULL || !is_op(code[i + 1], JMP) || !is_label_of(code[i + 2], code[i].args[0])) return false;
+    set_instr(code, i, inverse, code[i + 1].args);
+    code.erase(code.begin() + i + 1);
+    return true;
+}
+
+// the bytes an addq or subq moves %rsp by, 0 for anything else
+static long long stack_adjust(const AsmInstr &instr) {
+    if ((!is_op(instr, ADD) && !is_op(instr, SUB)) || instr.args.size() != 2) return 0;
+    if (!same_operand(instr.args[1], asm_reg(RSP)) || instr.args[0].kind != ASM_IMM) return 0;
+    return is_op(instr, ADD) ? instr.args[0].imm : -instr.args[0].imm;
+}
+
+// subq $8, %rsp; subq $8, %rsp  =>  subq $16, %rsp
+static bool merge_stack_adjust(AsmCode &code, unsigned int i) {
+    if (i + 1 >= code.size()) return false;
+    long long first = stack_adjust(code[i]), second = stack_adjust(code[i + 1]);
+    if (first == 0 || second == 0) return false;
+    long long total = first + second;
+    if (total == 0) {
+        code.erase(code.begin() + i, code.begin() + i + 2);
+        return true;
+    }
+    vector<AsmOperand> args;
+    args.push_back(asm_imm(total > 0 ? total : -total));
+    args.push_back(asm_reg(RSP));
+    set_instr(code, i, total > 0 ? ADD : SUB, args);
+    code.erase(code.begin() + i + 1);
+    return true;
+}
+
+typedef bool (*PeepholeRule)(AsmCode &code, unsigned int i);
+
+struct PeepholePattern {
+    const char *name;
+    PeepholeRule rewrite;
+    int hits;
+};
+
+static PeepholePattern patterns[] = {
+    {"self move", drop_self_move, 0},
+    {"store then reload", drop_reload, 0},
+    {"repeated move", drop_repeated_move, 0},
+    {"push then pop", drop_push_pop, 0},
+    {"jump to next label", drop_jump_to_next, 0},
+    {"branch over jump", invert_branch_over_jump, 0},
+    {"stack adjustments", merge_stack_adjust, 0}
+};
+#define PATTERN_COUNT (sizeof(patterns) / sizeof(patterns[0]))
+#define PEEPHOLE_WINDOW 3   // the most instructions any rule looks at
+
+void peephole_optimize(AsmCode &code) {
+    unsigned int i = 0;
+    while (i < code.size()) {
+        bool fired = false;
+        for (unsigned int p = 0; p < PATTERN_COUNT && !fired; ++p)
+            if (patterns[p].rewrite(code, i)) {
+                ++patterns[p].hits;
+                fired = true;
+            }
+        if (!fired) ++i;
+        // the rewrite may complete a pattern that starts a little earlier
+        else i = i >= PEEPHOLE_WINDOW - 1 ? i - (PEEPHOLE_WINDOW - 1) : 0;
+    }
+}
+
+void peephole_report(ostream &s) {
+    s << "Peephole patterns:\n";
+    for (unsigned int p = 0; p < PATTERN_COUNT; ++p)
+        s << "  " << patterns[p].name << ": " << patterns[p].hits << "\n";
+}
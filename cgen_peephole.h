@@ -0,0 +1,23 @@
+//**************************************************************
+//
+// Peephole optimiser over the instructions of a function
+//
+// A small window slides over the instructions the selector
+// recorded, trying each pattern of a table in turn.  A pattern
+// that matches rewrites the window, and the scan backs up so
+// rewrites can enable each other.
+//
+//**************************************************************
+
+#ifndef CGEN_PEEPHOLE_H
+#define CGEN_PEEPHOLE_H
+
+#include "cgen_asm.h"
+
+// rewrite the instructions of a function in place
+void peephole_optimize(AsmCode &code);
+
+// how often each pattern fired so far
+void peephole_report(ostream &s);
+
+#endif
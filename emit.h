@@ -74,6 +74,14 @@
 #define XMM5    "%xmm5"     // float register
 #define XMM6    "%xmm6"     // float register
 #define XMM7    "%xmm7"     // float register
+#define XMM8    "%xmm8"     // float register
+#define XMM9    "%xmm9"     // float register
+#define XMM10   "%xmm10"    // float register
+#define XMM11   "%xmm11"    // float register
+#define XMM12   "%xmm12"    // float register
+#define XMM13   "%xmm13"    // float register
+#define XMM14   "%xmm14"    // float register
+#define XMM15   "%xmm15"    // float register
 
 //
 // Opcodes
@@ -96,6 +104,10 @@
 #define OR      "\torq\t"
 #define NOT     "\tnotq\t"
 #define XOR     "\txorq\t"
+#define SAL     "\tsalq\t"
+#define SAR     "\tsarq\t"
+#define SHR     "\tshrq\t"
+#define LEA     "\tleaq\t"
 #define CMP     "\tcmpq\t"
 #define JMP     "\tjmp\t"
 #define JL      "\tjl\t"
@@ -123,6 +135,24 @@
 #define JAE     "\tjae\t"
 #define JP      "\tjp\t"
 #define JP      "\tjp\t"
+#define JNP     "\tjnp\t"
+
+// set a byte from the flags
+#define SETL    "\tsetl\t"
+#define SETLE   "\tsetle\t"
+#define SETE    "\tsete\t"
+#define SETNE   "\tsetne\t"
+#define SETG    "\tsetg\t"
+#define SETGE   "\tsetge\t"
+#define SETA    "\tseta\t"
+#define SETAE   "\tsetae\t"
+#define SETB    "\tsetb\t"
+#define SETBE   "\tsetbe\t"
+#define SETP    "\tsetp\t"
+#define SETNP   "\tsetnp\t"
+#define ANDB    "\tandb\t"
+#define ORB     "\torb\t"
+#define MOVZBQ  "\tmovzbq\t"
 
 // transform from float to int
 #define CVTTSD2SIQ "\tcvttsd2siq\t"
@@ -131,6 +161,39 @@
 // convert xmm to xmm
 #define MOVAPS "\tmovaps\t"
 
+// packed float, two doubles in an xmm register
+#define MOVAPD   "\tmovapd\t"
+#define MOVHPD   "\tmovhpd\t"
+#define UNPCKLPD "\tunpcklpd\t"
+#define UNPCKHPD "\tunpckhpd\t"
+#define ADDPD    "\taddpd\t"
+#define SUBPD    "\tsubpd\t"
+#define MULPD    "\tmulpd\t"
+#define DIVPD    "\tdivpd\t"
+
+// VEX forms, four doubles in a ymm register
+#define VMOVSD       "\tvmovsd\t"
+#define VMOVAPD      "\tvmovapd\t"
+#define VMOVAPS      "\tvmovaps\t"
+#define VMOVHPD      "\tvmovhpd\t"
+#define VUNPCKLPD    "\tvunpcklpd\t"
+#define VUNPCKHPD    "\tvunpckhpd\t"
+#define VADDSD       "\tvaddsd\t"
+#define VSUBSD       "\tvsubsd\t"
+#define VMULSD       "\tvmulsd\t"
+#define VDIVSD       "\tvdivsd\t"
+#define VADDPD       "\tvaddpd\t"
+#define VSUBPD       "\tvsubpd\t"
+#define VMULPD       "\tvmulpd\t"
+#define VDIVPD       "\tvdivpd\t"
+#define VCVTSI2SDQ   "\tvcvtsi2sdq\t"
+#define VBROADCASTSD "\tvbroadcastsd\t"
+#define VINSERTF128  "\tvinsertf128\t"
+#define VEXTRACTF128 "\tvextractf128\t"
+#define VZEROUPPER   "\tvzeroupper\t"
+
 // printf
 #define MOVL     "\tmovl\t" 
-#define EAX     "%eax"      // 32 bit general purpose register
\ No newline at end of file
+#define EAX     "%eax"      // 32 bit general purpose register
+#define AL      "%al"       // low byte of rax
+#define CL      "%cl"       // low byte of rcx
\ No newline at end of file
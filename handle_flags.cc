@@ -6,6 +6,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
 #include "seal-io.h"
 #include <unistd.h>
 #include "cgen_gc.h"
@@ -27,9 +29,13 @@ extern int seal_yydebug;        // for the parser
        int lex_verbose;         // also for the lexer; prints tokens
        int semant_debug;        // for semantic analysis
        int cgen_debug;          // for code gen
+       int cgen_dump_ir;        // dump the IR of every function
        bool disable_reg_alloc;  // Don't do register allocation
 
        int cgen_optimize;       // optimize switch for code generator 
+       int cgen_inline_threshold; // largest function (IR instructions) -O inlines
+       int cgen_vector_lanes;   // doubles per packed register -O vectorises with
+       int cgen_unroll_factor;  // copies of a loop body per iteration -O unrolls to
        char *out_filename;      // file name for generated code
        Memmgr cgen_Memmgr = GC_NOGC;      // enable/disable garbage collection
        Memmgr_Test cgen_Memmgr_Test = GC_NORMAL;  // normal/test GC
@@ -39,6 +45,14 @@ extern int seal_yydebug;        // for the parser
 extern int optind, opterr;
 extern char *optarg;
 
+// the value of a numeric option, or -1 unless it is an Int >= 1
+static long positive_arg(const char *arg) {
+  char *end;
+  long value = strtol(arg, &end, 10);
+  if (*arg == '\0' || *end != '\0' || value < 1 || value > INT_MAX) return -1;
+  return value;
+}
+
 void handle_flags(int argc, char *argv[]) {
   int c;
   int unknownopt = 0;
@@ -49,11 +63,15 @@ void handle_flags(int argc, char *argv[]) {
   lex_verbose  = 0;
   semant_debug = 0;
   cgen_debug = 0;
+  cgen_dump_ir = 0;
   cgen_optimize = 0;
+  cgen_inline_threshold = 32;
+  cgen_vector_lanes = 2;
+  cgen_unroll_factor = 4;
   disable_reg_alloc = 0;
   
 
-  while ((c = getopt(argc, argv, "lpscvrOo:gtT")) != -1) {
+  while ((c = getopt(argc, argv, "lpscivrOo:gtTI:m:u:")) != -1) {
     switch (c) {
 #ifdef DEBUG
     case 'l':
@@ -68,6 +86,9 @@ void handle_flags(int argc, char *argv[]) {
     case 'c':
       cgen_debug = 1;
       break;
+    case 'i':
+      cgen_dump_ir = 1;
+      break;
     case 'v':
       lex_verbose = 1;
       break;
@@ -79,6 +100,7 @@ void handle_flags(int argc, char *argv[]) {
     case 'p':
     case 's':
     case 'c': 
+    case 'i':
     case 'v':
     case 'r':
       cerr << "No debugging available\n";
@@ -99,6 +121,19 @@ void handle_flags(int argc, char *argv[]) {
     case 'O':  // enable optimization
       cgen_optimize = 1;
       break;
+    case 'I':  // set the inlining threshold
+      cgen_inline_threshold = positive_arg(optarg);
+      if (cgen_inline_threshold < 1) unknownopt = 1;
+      break;
+    case 'm':  // select the target: sse2 or avx2
+      if (strcmp(optarg, "sse2") == 0) cgen_vector_lanes = 2;
+      else if (strcmp(optarg, "avx2") == 0) cgen_vector_lanes = 4;
+      else unknownopt = 1;
+      break;
+    case 'u':  // set the unroll factor, 1 for none
+      cgen_unroll_factor = positive_arg(optarg);
+      if (cgen_unroll_factor < 1) unknownopt = 1;
+      break;
     case '?':
       unknownopt = 1;
       break;
@@ -111,9 +146,9 @@ void handle_flags(int argc, char *argv[]) {
   if (unknownopt) {
       cerr << "usage: " << argv[0] << 
 #ifdef DEBUG
-	  " [-lvpscOgtTr -o outname] [input-files]\n";
+	  " [-lvpsciOgtTr -I size -m sse2|avx2 -u factor -o outname] [input-files]\n";
 #else
-      " [-OgtT -o outname] [input-files]\n";
+      " [-OgtT -I size -m sse2|avx2 -u factor -o outname] [input-files]\n";
 #endif
       exit(1);
   }
@@ -1,20 +1,25 @@
 #!/bin/bash
 cd test
 for filename in *.seal; do
-    echo "--------Test using" $filename "--------"
     name=${filename//.seal}
-    ../cgen $filename -o $name.s
-    gcc $name.s -no-pie -o $name
-    ./$name > tempfile
-    ../test-answer/$name > tempfile2
-    diff tempfile tempfile2 > /dev/null
-    if [ $? -eq 0 ] ; then
-        echo passed
-    else
-        echo NOT passed
-    fi
-    rm -f $name
+    # with and without the optimiser, with inlining off and generous,
+    # with four-lane vectors, with unrolling off and by an odd factor,
+    # and without register allocation
+    for flags in "" "-O" "-O -I 1" "-O -I 200" "-O -m avx2" "-O -u 1" "-O -u 3" "-r"; do
+        echo "--------Test using" $filename $flags "--------"
+        ../cgen $flags $filename -o $name.s
+        gcc $name.s -no-pie -o $name
+        ./$name > tempfile
+        ../test-answer/$name > tempfile2
+        diff tempfile tempfile2 > /dev/null
+        if [ $? -eq 0 ] ; then
+            echo passed
+        else
+            echo NOT passed
+        fi
+        rm -f $name
+    done
 done
 
 rm -f tempfile tempfile2
-cd ..
\ No newline at end of file
+cd ..
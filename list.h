@@ -21,6 +21,7 @@
 
 #include "seal-io.h"  //includes iostream
 #include <stdlib.h>
+#include "arena.h"
 
 template <class T>
 class List {
@@ -30,6 +31,10 @@ private:
 public:
   List(T *h,List<T>* t = NULL): head(h), tail(t) { }
 
+  // cells live in the compilation arena
+  static void *operator new(size_t size) { return compile_arena.allocate(size); }
+  static void operator delete(void *) { }
+
   T *hd() const       { return head; }  
   List<T>* tl() const { return tail; }
 };
@@ -319,6 +319,7 @@ public:
    bool is_empty_Expr(){ return false;}
    Symbol checkType();
    void code(ostream&);
+   void code_branch(int on_true, int on_false, ostream&);
 };
 
 // define constructor - or ||
@@ -337,6 +338,7 @@ public:
    bool is_empty_Expr(){ return false;}
    Symbol checkType();
    void code(ostream&);
+   void code_branch(int on_true, int on_false, ostream&);
 };
 
 // define constructor - xor ^
@@ -371,6 +373,7 @@ public:
    bool is_empty_Expr(){ return false;}
    Symbol checkType();
    void code(ostream&);
+   void code_branch(int on_true, int on_false, ostream&);
 };
 
 // define constructor - bitnot ~
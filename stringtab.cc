@@ -20,7 +20,7 @@ template class StringTable<IntEntry>;
 template class StringTable<FloatEntry>;
 
 Entry::Entry(char *s, int l, int i) : len(l), index(i) {
-  str = new char [len+1];
+  str = (char *) compile_arena.allocate(len+1);
   strncpy(str, s, len);
   str[len] = '\0';
 }
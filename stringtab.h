@@ -11,6 +11,7 @@
 
 #include <assert.h>
 #include <string.h>
+#include <vector>
 #include "list.h"    // list template
 #include "seal-io.h"
 
@@ -34,11 +35,16 @@ protected:
 public:
   Entry(char *s, int l, int i);
 
+  // entries and their strings live in the compilation arena
+  static void *operator new(size_t size) { return compile_arena.allocate(size); }
+  static void operator delete(void *) { }
+
   // is string argument equal to the str of this Entry?
   int equal_string(char *s, int len) const;  
                          
   // is the integer argument equal to the index of this Entry?
   bool equal_index(int ind) const           { return ind == index; }
+  int get_index() const                     { return index; }
 
   ostream& print(ostream& s) const;
 
@@ -100,10 +106,15 @@ template <class Elem>
 class StringTable
 {
 protected:
-   List<Elem> *tbl;   // a string table is a list
-   int index;         // the current index
+   std::vector<Elem *> tbl;   // the entries, tbl[i] has index i
+   int index;                 // the current index
+   int *slots;                // open addressing hash of the strings: an index into tbl or -1
+   int capacity;              // number of slots, a power of 2
+
+   int find_slot(char *s, int len);   // the slot holding s, or the empty slot where it goes
+   void grow();                       // double the slots and rehash
 public:
-   StringTable(): tbl((List<Elem> *) NULL), index(0) { }   // an empty table
+   StringTable(): index(0), slots((int *) NULL), capacity(0) { }   // an empty table
    // The following methods each add a string to the string table.  
    // Only one copy of each string is maintained.  
    // Returns a pointer to the string table entry with the string.
@@ -12,10 +12,44 @@
 #include <stdio.h>
 
 //
-// A string table is implemented a linked list of Entrys.  Each Entry
-// in the list has a unique string.
+// A string table is implemented as a vector of Entrys, indexed by their
+// index, and an open addressing hash table (linear probing) from
+// strings to those indices.  Each Entry in the table has a unique string.
 //
 
+// FNV-1a over the first len characters of s
+static unsigned int hash_string(char *s, int len)
+{
+  unsigned int h = 2166136261u;
+  for (int i = 0; i < len; i++) {
+    h ^= (unsigned char) s[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+template <class Elem>
+int StringTable<Elem>::find_slot(char *s, int len)
+{
+  int mask = capacity - 1;
+  int i = hash_string(s, len) & mask;
+  while (slots[i] != -1 && !tbl[slots[i]]->equal_string(s, len))
+    i = (i + 1) & mask;
+  return i;
+}
+
+template <class Elem>
+void StringTable<Elem>::grow()
+{
+  delete [] slots;
+  capacity = capacity ? capacity * 2 : 64;
+  slots = new int[capacity];
+  for (int i = 0; i < capacity; i++)
+    slots[i] = -1;
+  for (int i = 0; i < index; i++)
+    slots[find_slot(tbl[i]->get_string(), tbl[i]->get_len())] = i;
+}
+
 template <class Elem>
 Elem *StringTable<Elem>::add_string(char *s)
 {
@@ -23,38 +57,40 @@ Elem *StringTable<Elem>::add_string(char *s)
 }
 
 //
-// Add a string requires two steps.  First, the list is searched; if the
-// string is found, a pointer to the existing Entry for that string is 
+// Add a string requires two steps.  First, the hash table is probed; if
+// the string is found, a pointer to the existing Entry for that string is
 // returned.  If the string is not found, a new Entry is created and added
-// to the list.
+// to the table.
 //
 template <class Elem>
 Elem *StringTable<Elem>::add_string(char *s, int maxchars)
 {
   int len = min((int) strlen(s),maxchars);
-  for(List<Elem> *l = tbl; l; l = l->tl())
-    if (l->hd()->equal_string(s,len))
-      return l->hd();
+  // keep the load factor at most 1/2
+  if (2 * (index + 1) > capacity)
+    grow();
+  int slot = find_slot(s, len);
+  if (slots[slot] != -1)
+    return tbl[slots[slot]];
 
-  Elem *e = new Elem(s,len,index++);
-  tbl = new List<Elem>(e, tbl);
+  Elem *e = new Elem(s,len,index);
+  tbl.push_back(e);
+  slots[slot] = index++;
   return e;
 }
 
 //
-// To look up a string, the list is scanned until a matching Entry is located.
-// If no such entry is found, an assertion failure occurs.  Thus, this function
-// is used only for strings that one expects to find in the table.
+// To look up a string, the hash table is probed until a matching Entry is
+// located.  If no such entry is found, an assertion failure occurs.  Thus,
+// this function is used only for strings that one expects to find in the table.
 //
 template <class Elem>
 Elem *StringTable<Elem>::lookup_string(char *s)
 {
-  int len = strlen(s);
-  for(List<Elem> *l = tbl; l; l = l->tl())
-    if (l->hd()->equal_string(s,len))
-      return l->hd();
-  assert(0);   // fail if string is not found
-  return NULL; // to avoid compiler warning
+  assert(capacity > 0);   // fail if the table is empty
+  int slot = find_slot(s, strlen(s));
+  assert(slots[slot] != -1);   // fail if string is not found
+  return tbl[slots[slot]];
 }
 
 //
@@ -64,11 +100,8 @@ Elem *StringTable<Elem>::lookup_string(char *s)
 template <class Elem>
 Elem *StringTable<Elem>::lookup(int ind)
 {
-  for(List<Elem> *l = tbl; l; l = l->tl())
-    if (l->hd()->equal_index(ind))
-      return l->hd();
-  assert(0);   // fail if string is not found
-  return NULL; // to avoid compiler warning
+  assert(ind >= 0 && ind < index);   // fail if string is not found
+  return tbl[ind];
 }
 
 //
@@ -103,5 +136,8 @@ int StringTable<Elem>::next(int i)
 template <class Elem>
 void StringTable<Elem>::print()
 {
-  list_print(cerr,tbl);
+  cerr << "[\n";
+  for (int i = 0; i < index; i++)
+    cerr << *tbl[i] << " ";
+  cerr << "]\n";
 }
@@ -14,6 +14,8 @@
 #ifndef _SYMTAB_H_
 #define _SYMTAB_H_
 
+#include <vector>
+#include <functional>
 #include "list.h"
 
 //
@@ -28,44 +30,37 @@ private:
   DAT *info;     // associated information for the symbol
 public:
   SymtabEntry(SYM x, DAT *y) : id(x), info(y) { }
+
+  // entries live in the compilation arena
+  static void *operator new(size_t size) { return compile_arena.allocate(size); }
+  static void operator delete(void *) { }
+
   SYM get_id() const    { return id; }
   DAT *get_info() const { return info; }
 };
 
 //
 // SymbolTable<SYM,DAT> describes a symbol table mapping symbols of
-//    type `SYM' to data of type `DAT *'.  It is implemented as a
-//    list of lists of `SymtabEntry<SYM,DAT> *'.  The inner list is
-//    a scope, a mapping from symbols to data, and the outer list is
-//    a list of scopes. 
-//
-//    `tbl' points to the current top scope.
+//    type `SYM' to data of type `DAT *'.  It is implemented as an
+//    open addressing hash table keyed on the symbol.  Each slot
+//    holds the chain of bindings of its symbol, innermost first; a
+//    binding records the scope depth it was made in.  An undo log
+//    lists the symbols bound in each open scope.
 //
-//    `enterscope' makes the table point to a new scope whose parent
-//       is the scope it pointed to previously.
+//    `enterscope' opens a new scope inside the current one.
 //
-//    `exitscope' makes the table point to the parent scope of the
-//        current scope.  Note that the old child scope is not
-//        deallocated.  One may save the state of a symbol table
-//        at a given point by copying it with `operator ='
+//    `exitscope' pops the bindings the current scope made, so the
+//        ones they shadowed become visible again.  It takes time
+//        proportional to the entries of that scope.
 //
 //    `addid(s,i)' adds a symbol table entry to the current scope of
-//        the symbol table mapping symbol `s' to data `d'.  The old
-//        top scope isn't modified; a new scope is created whose
-//        entry list is the new entry followed by the old entry list,
-//        and whose tail is the old top scope's parent.  The table
-//        is made to point to this new scope.
+//        the symbol table mapping symbol `s' to data `d'.
 //
-//    `lookup(s)' looks for the symbol `s', starting at the top scope
-//        and proceeding down the list of scopes until either an
-//        entry is found whose `get_id()' equals `s', or the end of
-//        the root scope is reached.  It returns the data item
-//        associated with the entry, or NULL if no such entry exists.
+//    `lookup(s)' returns the data of the innermost binding of `s',
+//        or NULL if `s' is not bound.
 //
-//    
-//    `probe(s)' checks the top scope for an entry whose `get_id()'
-//        equals `s', and returns the entry's `get_info()' if
-//        found, and NULL otherwise.
+//    `probe(s)' returns the data of `s' if it is bound in the top
+//        scope, and NULL otherwise.
 //
 //    `dump()' prints the symbols in the symbol table.
 //
@@ -74,15 +69,65 @@ template <class SYM, class DAT>
 class SymbolTable
 {
    typedef SymtabEntry<SYM,DAT> ScopeEntry;
-   typedef List<ScopeEntry> Scope;
-   typedef List<Scope> ScopeList;
+
+   // one binding of a symbol; `shadowed' is the binding it hides
+   struct Binding {
+      ScopeEntry *entry;
+      int depth;
+      Binding *shadowed;
+
+      static void *operator new(size_t size) { return compile_arena.allocate(size); }
+      static void operator delete(void *) { }
+   };
 private:
-   ScopeList  *tbl;
-public:
-   SymbolTable(): tbl(NULL) { }     // create a new symbol table
+   std::vector<SYM> keys;           // the symbol of each slot
+   std::vector<Binding *> heads;    // innermost binding of each slot, NULL if none
+   int used;                        // slots with a key
+   std::vector<SYM> added;          // undo log: symbols bound, in order
+   std::vector<int> scopes;         // start of each open scope in `added'
+
+   static size_t hash(SYM s)
+   {
+       // spread the low bits of the interned pointer
+       return std::hash<SYM>()(s) * 0x9E3779B97F4A7C15ULL >> 16;
+   }
+
+   // the slot of `s', or the empty slot where it goes
+   int find_slot(SYM s)
+   {
+       int mask = keys.size() - 1;
+       int i = hash(s) & mask;
+       while (keys[i] != SYM()) {
+	   if (keys[i] == s) return i;
+	   i = (i + 1) & mask;
+       }
+       return i;
+   }
+
+   // double the slots and rehash, keeping the load factor at most 1/2
+   void grow()
+   {
+       std::vector<SYM> old_keys(keys);
+       std::vector<Binding *> old_heads(heads);
+       int size = keys.empty() ? 64 : keys.size() * 2;
+       keys.assign(size, SYM());
+       heads.assign(size, (Binding *) NULL);
+       for (unsigned int i = 0; i < old_keys.size(); i++) {
+	   if (old_keys[i] == SYM()) continue;
+	   int slot = find_slot(old_keys[i]);
+	   keys[slot] = old_keys[i];
+	   heads[slot] = old_heads[i];
+       }
+   }
 
-   // Create pointer to current symbol table.
-   SymbolTable &operator =(const SymbolTable &s) { tbl = s.tbl; return *this; }
+   Binding *innermost(SYM s)
+   {
+       if (keys.empty()) return NULL;
+       int slot = find_slot(s);
+       return keys[slot] == s ? heads[slot] : NULL;
+   }
+public:
+   SymbolTable(): used(0) { }     // create a new symbol table
 
    void fatal_error(char * msg)
    {
@@ -90,36 +135,47 @@ public:
      exit(1);
    } 
 
-   // Enter a new scope.  A symbol table is organized as a list of
-   // lists.  The head of the list is the innermost scope, the tail
-   // holds the outer scopes.  A scope must be entered before anything
+   // Enter a new scope.  A scope must be entered before anything
    // can be added to the table.
 
    void enterscope()
    {
-       // The cast of NULL is required for template instantiation to work
-       // correctly.
-       tbl = new ScopeList((Scope *) NULL, tbl);
+       scopes.push_back(added.size());
    }
 
    // Pop the first scope off of the symbol table.
    void exitscope()
    {
        // It is an error to exit a scope that doesn't exist.
-       if (tbl == NULL) {
+       if (scopes.empty()) {
 	   fatal_error("exitscope: Can't remove scope from an empty symbol table.");
        }
-       tbl = tbl->tl();
+       for (int i = added.size() - 1; i >= scopes.back(); i--) {
+	   int slot = find_slot(added[i]);
+	   heads[slot] = heads[slot]->shadowed;
+       }
+       added.resize(scopes.back());
+       scopes.pop_back();
    }
 
    // Add an item to the symbol table.
    ScopeEntry *addid(SYM s, DAT *i)
    {
        // There must be at least one scope to add a symbol.
-       if (tbl == NULL) fatal_error("addid: Can't add a symbol without a scope.");
-       ScopeEntry * se = new ScopeEntry(s,i);
-       tbl = new ScopeList(new Scope(se, tbl->hd()), tbl->tl());
-       return(se);
+       if (scopes.empty()) fatal_error("addid: Can't add a symbol without a scope.");
+       if (2 * (used + 1) > (int) keys.size()) grow();
+       int slot = find_slot(s);
+       if (keys[slot] != s) {
+	   keys[slot] = s;
+	   used++;
+       }
+       Binding *b = new Binding;
+       b->entry = new ScopeEntry(s,i);
+       b->depth = scopes.size();
+       b->shadowed = heads[slot];
+       heads[slot] = b;
+       added.push_back(s);
+       return(b->entry);
    }
    
    // Lookup an item through all scopes of the symbol table.  If found
@@ -128,39 +184,30 @@ public:
 
    DAT * lookup(SYM s)
    {
-       for(ScopeList *i = tbl; i != NULL; i=i->tl()) {
-	   for( Scope *j = i->hd(); j != NULL; j = j->tl()) {
-	       if (s == j->hd()->get_id()) {
-		   return (j->hd()->get_info());
-	       }
-	   }
-       }
-       return NULL;
+       Binding *b = innermost(s);
+       return b ? b->entry->get_info() : NULL;
    }
 
    // probe the symbol table.  Check the top scope (only) for the item
    // 's'.  If found, return the information field.  If not return NULL.
    DAT *probe(SYM s)
    {
-       if (tbl == NULL) {
+       if (scopes.empty()) {
 	   fatal_error("probe: No scope in symbol table.");
        }
-       for(Scope *i = tbl->hd(); i != NULL; i = i->tl()) {
-	   if (s == i->hd()->get_id()) {
-	       return(i->hd()->get_info());
-	   }
-       }
-       return(NULL);
+       Binding *b = innermost(s);
+       return (b && b->depth == (int) scopes.size()) ? b->entry->get_info() : NULL;
    }
 
    // Prints out the contents of the symbol table  
    void dump()
    {
-      for(ScopeList *i = tbl; i != NULL; i = i->tl()) {
+      int end = added.size();
+      for (int d = scopes.size() - 1; d >= 0; d--) {
          cerr << "\nScope: \n";
-         for(Scope *j = i->hd(); j != NULL; j = j->tl()) {
-            cerr << "  " << j->hd()->get_id() << endl;
-         }
+         for (int i = end - 1; i >= scopes[d]; i--)
+            cerr << "  " << added[i] << endl;
+         end = scopes[d];
       }
    }
  
@@ -0,0 +1,69 @@
+# start of generated code
+	.data	
+	.section		.rodata	
+.LC0:
+	.string	"gcd(23398, 14567) = %lld \n "
+	.text	
+	.globl	euclidean
+	.type	euclidean, @function
+euclidean:
+	movq	%rdi, -8(%rsp)
+	movq	%rsi, -16(%rsp)
+.POS0:
+	movq	-8(%rsp), %rax
+	cmpq	-16(%rsp), %rax
+	jge	.POS2
+.POS1:
+	movq	-8(%rsp), %rax
+	movq	%rax, -24(%rsp)
+	movq	-16(%rsp), %rax
+	movq	%rax, -8(%rsp)
+	movq	-24(%rsp), %rax
+	movq	%rax, -16(%rsp)
+	jmp	.POS3
+.POS2:
+.POS3:
+.POS4:
+	movq	-8(%rsp), %rax
+	cqto	
+	idivq	-16(%rsp)
+	movq	%rdx, -32(%rsp)
+	cmpq	$0, -32(%rsp)
+	je	.POS6
+.POS5:
+	movq	-16(%rsp), %rax
+	movq	%rax, -24(%rsp)
+	movq	-8(%rsp), %rax
+	cqto	
+	idivq	-16(%rsp)
+	movq	%rdx, -32(%rsp)
+	movq	-32(%rsp), %rax
+	movq	%rax, -16(%rsp)
+	movq	-24(%rsp), %rax
+	movq	%rax, -8(%rsp)
+	jmp	.POS4
+.POS6:
+	movq	-16(%rsp), %rax
+	ret	
+	.size	euclidean, .-euclidean
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+.POS7:
+	movq	$23398, -8(%rbp)
+	movq	$14567, -16(%rbp)
+	movq	-8(%rbp), %rdi
+	movq	-16(%rbp), %rsi
+	call	euclidean
+	movq	%rax, -24(%rbp)
+	movq	$.LC0, %rdi
+	movq	-24(%rbp), %rsi
+	movl	$0, %eax
+	leave	
+	jmp	printf
+	.size	main, .-main
+
+# end of generated code
@@ -0,0 +1,74 @@
+# start of generated code
+	.data	
+	.section		.rodata	
+.LC0:
+	.string	"fib(%lld) = %lld \n"
+	.text	
+	.globl	fib
+	.type	fib, @function
+fib:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+	movq	%rdi, -8(%rbp)
+.POS0:
+	cmpq	$2, -8(%rbp)
+	jg	.POS2
+.POS1:
+	movq	$1, %rax
+	leave	
+	ret	
+.POS2:
+.POS3:
+	movq	-8(%rbp), %rax
+	subq	$1, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rdi
+	call	fib
+	movq	%rax, -24(%rbp)
+	movq	-8(%rbp), %rax
+	subq	$2, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rdi
+	call	fib
+	movq	%rax, -8(%rbp)
+	movq	-24(%rbp), %rax
+	addq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	leave	
+	ret	
+	.size	fib, .-fib
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+.POS4:
+	movq	$1, -8(%rbp)
+.POS5:
+	cmpq	$15, -8(%rbp)
+	jge	.POS8
+.POS6:
+	movq	-8(%rbp), %rdi
+	call	fib
+	movq	%rax, -16(%rbp)
+	movq	$.LC0, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+.POS7:
+	movq	-8(%rbp), %rax
+	addq	$1, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -8(%rbp)
+	jmp	.POS5
+.POS8:
+	leave	
+	ret	
+	.size	main, .-main
+
+# end of generated code
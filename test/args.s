@@ -0,0 +1,475 @@
+# start of generated code
+	.data	
+	.globl	g
+	.align	8
+	.type	g, @object
+	.size	g, 8
+g:
+	.quad	0
+	.section		.rodata	
+.LC0:
+	.string	"%lld %lld %lld %lld %lld %lld\n"
+.LC1:
+	.string	"%lld %lld %lld %lld %lld %lld %lld %lld %lld\n"
+.LC2:
+	.string	"%f %f %f %f %f %f %f %f %f %f\n"
+.LC3:
+	.string	"%lld %f %lld %f %lld %f %lld %f %lld %f %lld %f %lld %f %lld\n"
+.LC4:
+	.string	"%f\n"
+.LC5:
+	.string	"%lld\n"
+.LC6:
+	.string	"%lld %lld\n"
+	.text	
+	.globl	mix
+	.type	mix, @function
+mix:
+	subq	$152, %rsp
+	movq	%rdi, 144(%rsp)
+	movsd	%xmm0, 136(%rsp)
+	movq	%rsi, 128(%rsp)
+	movq	%rdx, 120(%rsp)
+	movsd	%xmm1, 112(%rsp)
+	movq	%rcx, 104(%rsp)
+	movq	%r8, 96(%rsp)
+	movq	%r9, 88(%rsp)
+	movq	160(%rsp), %rax
+	movq	%rax, 80(%rsp)
+	movsd	%xmm2, 72(%rsp)
+	movq	168(%rsp), %rax
+	movq	%rax, 64(%rsp)
+	movsd	%xmm3, 56(%rsp)
+	movsd	%xmm4, 48(%rsp)
+	movsd	%xmm5, 40(%rsp)
+	movsd	%xmm6, 32(%rsp)
+	movsd	%xmm7, 24(%rsp)
+	movq	176(%rsp), %rax
+	movq	%rax, 16(%rsp)
+	movq	184(%rsp), %rax
+	movq	%rax, 8(%rsp)
+.POS0:
+	movq	128(%rsp), %rax
+	salq	$1, %rax
+	movq	%rax, 0(%rsp)
+	movq	144(%rsp), %rax
+	subq	0(%rsp), %rax
+	movq	%rax, 128(%rsp)
+	movq	120(%rsp), %rax
+	leaq	(%rax, %rax, 2), %rax
+	movq	%rax, 144(%rsp)
+	movq	128(%rsp), %rax
+	addq	144(%rsp), %rax
+	movq	%rax, 120(%rsp)
+	movq	104(%rsp), %rax
+	salq	$2, %rax
+	movq	%rax, 144(%rsp)
+	movq	120(%rsp), %rax
+	subq	144(%rsp), %rax
+	movq	%rax, 128(%rsp)
+	movq	96(%rsp), %rax
+	leaq	(%rax, %rax, 4), %rax
+	movq	%rax, 144(%rsp)
+	movq	128(%rsp), %rax
+	addq	144(%rsp), %rax
+	movq	%rax, 120(%rsp)
+	movq	88(%rsp), %rax
+	leaq	(%rax, %rax, 2), %rax
+	salq	$1, %rax
+	movq	%rax, 144(%rsp)
+	movq	120(%rsp), %rax
+	subq	144(%rsp), %rax
+	movq	%rax, 128(%rsp)
+	movq	80(%rsp), %rax
+	imulq	$7, %rax
+	movq	%rax, 144(%rsp)
+	movq	128(%rsp), %rax
+	addq	144(%rsp), %rax
+	movq	%rax, 120(%rsp)
+	movq	64(%rsp), %rax
+	salq	$3, %rax
+	movq	%rax, 144(%rsp)
+	movq	120(%rsp), %rax
+	subq	144(%rsp), %rax
+	movq	%rax, 128(%rsp)
+	movq	8(%rsp), %rax
+	leaq	(%rax, %rax, 8), %rax
+	movq	%rax, 144(%rsp)
+	movq	128(%rsp), %rax
+	addq	144(%rsp), %rax
+	movq	%rax, 120(%rsp)
+	movsd	136(%rsp), %xmm5
+	mulsd	.FL19(%rip), %xmm5
+	movsd	%xmm5, 144(%rsp)
+	movq	120(%rsp), %rax
+	cvtsi2sdq	%rax, %xmm5
+	movsd	%xmm5, 136(%rsp)
+	movsd	136(%rsp), %xmm5
+	addsd	144(%rsp), %xmm5
+	movsd	%xmm5, 128(%rsp)
+	movsd	112(%rsp), %xmm5
+	mulsd	.FL20(%rip), %xmm5
+	movsd	%xmm5, 144(%rsp)
+	movsd	128(%rsp), %xmm5
+	addsd	144(%rsp), %xmm5
+	movsd	%xmm5, 136(%rsp)
+	movsd	72(%rsp), %xmm5
+	mulsd	.FL21(%rip), %xmm5
+	movsd	%xmm5, 144(%rsp)
+	movsd	136(%rsp), %xmm5
+	addsd	144(%rsp), %xmm5
+	movsd	%xmm5, 128(%rsp)
+	movsd	128(%rsp), %xmm5
+	addsd	56(%rsp), %xmm5
+	movsd	%xmm5, 144(%rsp)
+	movsd	48(%rsp), %xmm5
+	mulsd	.FL22(%rip), %xmm5
+	movsd	%xmm5, 136(%rsp)
+	movsd	144(%rsp), %xmm5
+	addsd	136(%rsp), %xmm5
+	movsd	%xmm5, 128(%rsp)
+	movsd	40(%rsp), %xmm5
+	mulsd	.FL23(%rip), %xmm5
+	movsd	%xmm5, 144(%rsp)
+	movsd	128(%rsp), %xmm5
+	addsd	144(%rsp), %xmm5
+	movsd	%xmm5, 136(%rsp)
+	movsd	32(%rsp), %xmm5
+	mulsd	.FL24(%rip), %xmm5
+	movsd	%xmm5, 144(%rsp)
+	movsd	136(%rsp), %xmm5
+	addsd	144(%rsp), %xmm5
+	movsd	%xmm5, 128(%rsp)
+	movsd	24(%rsp), %xmm5
+	mulsd	.FL25(%rip), %xmm5
+	movsd	%xmm5, 144(%rsp)
+	movsd	128(%rsp), %xmm5
+	addsd	144(%rsp), %xmm5
+	movsd	%xmm5, 136(%rsp)
+	movsd	16(%rsp), %xmm5
+	mulsd	.FL26(%rip), %xmm5
+	movsd	%xmm5, 144(%rsp)
+	movsd	136(%rsp), %xmm5
+	addsd	144(%rsp), %xmm5
+	movsd	%xmm5, 128(%rsp)
+	movq	128(%rsp), %rax
+	addq	$152, %rsp
+	ret	
+	.size	mix, .-mix
+	.globl	sum8
+	.type	sum8, @function
+sum8:
+	movq	%rdi, -8(%rsp)
+	movq	%rsi, -16(%rsp)
+	movq	%rdx, -24(%rsp)
+	movq	%rcx, -32(%rsp)
+	movq	%r8, -40(%rsp)
+	movq	%r9, -48(%rsp)
+	movq	8(%rsp), %rax
+	movq	%rax, -56(%rsp)
+	movq	16(%rsp), %rax
+	movq	%rax, -64(%rsp)
+.POS1:
+	movq	-16(%rsp), %rax
+	leaq	(%rax, %rax, 4), %rax
+	salq	$1, %rax
+	movq	%rax, -72(%rsp)
+	movq	-8(%rsp), %rax
+	addq	-72(%rsp), %rax
+	movq	%rax, -16(%rsp)
+	movq	-24(%rsp), %rax
+	imulq	$100, %rax
+	movq	%rax, -8(%rsp)
+	movq	-16(%rsp), %rax
+	addq	-8(%rsp), %rax
+	movq	%rax, -24(%rsp)
+	movq	-32(%rsp), %rax
+	imulq	$1000, %rax
+	movq	%rax, -8(%rsp)
+	movq	-24(%rsp), %rax
+	addq	-8(%rsp), %rax
+	movq	%rax, -16(%rsp)
+	movq	-40(%rsp), %rax
+	imulq	$10000, %rax
+	movq	%rax, -8(%rsp)
+	movq	-16(%rsp), %rax
+	addq	-8(%rsp), %rax
+	movq	%rax, -24(%rsp)
+	movq	-48(%rsp), %rax
+	imulq	$100000, %rax
+	movq	%rax, -8(%rsp)
+	movq	-24(%rsp), %rax
+	addq	-8(%rsp), %rax
+	movq	%rax, -16(%rsp)
+	movq	-56(%rsp), %rax
+	imulq	$1000000, %rax
+	movq	%rax, -8(%rsp)
+	movq	-16(%rsp), %rax
+	addq	-8(%rsp), %rax
+	movq	%rax, -24(%rsp)
+	movq	-64(%rsp), %rax
+	imulq	$10000000, %rax
+	movq	%rax, -8(%rsp)
+	movq	-24(%rsp), %rax
+	addq	-8(%rsp), %rax
+	movq	%rax, -16(%rsp)
+	movq	-16(%rsp), %rax
+	ret	
+	.size	sum8, .-sum8
+	.globl	tail
+	.type	tail, @function
+tail:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$64, %rsp
+	movq	%rdi, -8(%rbp)
+.POS2:
+	movq	g(%rip), %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	addq	-8(%rbp), %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rax
+	movq	%rax, g(%rip)
+	movq	-8(%rbp), %rax
+	addq	$1, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	addq	$2, %rax
+	movq	%rax, -24(%rbp)
+	movq	-8(%rbp), %rax
+	addq	$3, %rax
+	movq	%rax, -32(%rbp)
+	movq	-8(%rbp), %rax
+	addq	$4, %rax
+	movq	%rax, -40(%rbp)
+	movq	-8(%rbp), %rax
+	addq	$5, %rax
+	movq	%rax, -48(%rbp)
+	movq	-8(%rbp), %rax
+	addq	$6, %rax
+	movq	%rax, -56(%rbp)
+	movq	-8(%rbp), %rax
+	addq	$7, %rax
+	movq	%rax, -64(%rbp)
+	pushq	-64(%rbp)
+	pushq	-56(%rbp)
+	movq	-8(%rbp), %rdi
+	movq	-16(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movq	-32(%rbp), %rcx
+	movq	-40(%rbp), %r8
+	movq	-48(%rbp), %r9
+	call	sum8
+	addq	$16, %rsp
+	leave	
+	ret	
+	.size	tail, .-tail
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$80, %rsp
+.POS3:
+	movq	$7, -8(%rbp)
+	movq	.FL27(%rip), %rax
+	movq	%rax, -16(%rbp)
+	subq	$8, %rsp
+	pushq	$6
+	movq	$.LC0, %rdi
+	movq	$1, %rsi
+	movq	$2, %rdx
+	movq	$3, %rcx
+	movq	$4, %r8
+	movq	$5, %r9
+	movl	$0, %eax
+	call	printf
+	addq	$16, %rsp
+	movq	-8(%rbp), %rax
+	addq	$1, %rax
+	movq	%rax, -24(%rbp)
+	movq	-8(%rbp), %rax
+	addq	$2, %rax
+	movq	%rax, -32(%rbp)
+	movq	-8(%rbp), %rax
+	addq	$3, %rax
+	movq	%rax, -40(%rbp)
+	movq	-8(%rbp), %rax
+	addq	$4, %rax
+	movq	%rax, -48(%rbp)
+	movq	-8(%rbp), %rax
+	addq	$5, %rax
+	movq	%rax, -56(%rbp)
+	movq	-8(%rbp), %rax
+	addq	$6, %rax
+	movq	%rax, -64(%rbp)
+	movq	-8(%rbp), %rax
+	addq	$7, %rax
+	movq	%rax, -72(%rbp)
+	movq	$9223372036854775807, %rax
+	pushq	%rax
+	pushq	-72(%rbp)
+	pushq	-64(%rbp)
+	pushq	-56(%rbp)
+	movq	$.LC1, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movq	-32(%rbp), %rcx
+	movq	-40(%rbp), %r8
+	movq	-48(%rbp), %r9
+	movl	$0, %eax
+	call	printf
+	addq	$32, %rsp
+	movsd	-16(%rbp), %xmm5
+	addsd	.FL28(%rip), %xmm5
+	movsd	%xmm5, -24(%rbp)
+	movsd	-16(%rbp), %xmm5
+	addsd	.FL22(%rip), %xmm5
+	movsd	%xmm5, -32(%rbp)
+	movsd	-16(%rbp), %xmm5
+	addsd	.FL23(%rip), %xmm5
+	movsd	%xmm5, -40(%rbp)
+	movsd	-16(%rbp), %xmm5
+	addsd	.FL24(%rip), %xmm5
+	movsd	%xmm5, -48(%rbp)
+	movsd	-16(%rbp), %xmm5
+	addsd	.FL25(%rip), %xmm5
+	movsd	%xmm5, -56(%rbp)
+	movsd	-16(%rbp), %xmm5
+	addsd	.FL26(%rip), %xmm5
+	movsd	%xmm5, -64(%rbp)
+	movsd	-16(%rbp), %xmm5
+	addsd	.FL29(%rip), %xmm5
+	movsd	%xmm5, -72(%rbp)
+	movsd	-16(%rbp), %xmm5
+	addsd	.FL30(%rip), %xmm5
+	movsd	%xmm5, -80(%rbp)
+	pushq	.FL21(%rip)
+	pushq	-80(%rbp)
+	movq	$.LC2, %rdi
+	movsd	-16(%rbp), %xmm0
+	movsd	-24(%rbp), %xmm1
+	movsd	-32(%rbp), %xmm2
+	movsd	-40(%rbp), %xmm3
+	movsd	-48(%rbp), %xmm4
+	movsd	-56(%rbp), %xmm5
+	movsd	-64(%rbp), %xmm6
+	movsd	-72(%rbp), %xmm7
+	movl	$8, %eax
+	call	printf
+	addq	$16, %rsp
+	subq	$8, %rsp
+	pushq	-8(%rbp)
+	pushq	$7
+	pushq	$6
+	movq	$.LC3, %rdi
+	movq	$1, %rsi
+	movsd	.FL28(%rip), %xmm0
+	movq	$2, %rdx
+	movsd	.FL22(%rip), %xmm1
+	movq	$3, %rcx
+	movsd	.FL23(%rip), %xmm2
+	movq	$4, %r8
+	movsd	.FL24(%rip), %xmm3
+	movq	$5, %r9
+	movsd	.FL25(%rip), %xmm4
+	movsd	.FL26(%rip), %xmm5
+	movsd	.FL29(%rip), %xmm6
+	movl	$7, %eax
+	call	printf
+	addq	$32, %rsp
+	pushq	-8(%rbp)
+	pushq	.FL31(%rip)
+	pushq	$11
+	pushq	$9
+	movq	$1, %rdi
+	movsd	.FL22(%rip), %xmm0
+	movq	$3, %rsi
+	movq	$4, %rdx
+	movsd	.FL25(%rip), %xmm1
+	movq	$6, %rcx
+	movq	$7, %r8
+	movq	$8, %r9
+	movsd	.FL32(%rip), %xmm2
+	movsd	.FL33(%rip), %xmm3
+	movsd	.FL34(%rip), %xmm4
+	movsd	.FL35(%rip), %xmm5
+	movsd	.FL36(%rip), %xmm6
+	movsd	.FL37(%rip), %xmm7
+	call	mix
+	addq	$32, %rsp
+	movq	%rax, -16(%rbp)
+	movq	$.LC4, %rdi
+	movsd	-16(%rbp), %xmm0
+	movl	$1, %eax
+	call	printf
+	pushq	-8(%rbp)
+	pushq	$7
+	movq	$1, %rdi
+	movq	$2, %rsi
+	movq	$3, %rdx
+	movq	$4, %rcx
+	movq	$5, %r8
+	movq	$6, %r9
+	call	sum8
+	addq	$16, %rsp
+	movq	%rax, -16(%rbp)
+	movq	$.LC5, %rdi
+	movq	-16(%rbp), %rsi
+	movl	$0, %eax
+	call	printf
+	movq	$2, %rdi
+	call	tail
+	movq	%rax, -8(%rbp)
+	movq	g(%rip), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC6, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movl	$0, %eax
+	leave	
+	jmp	printf
+	.size	main, .-main
+	.section		.rodata	
+	.align	8
+.FL19:
+	.quad	0x3fe0000000000000
+.FL20:
+	.quad	0x3fd0000000000000
+.FL21:
+	.quad	0x3fc0000000000000
+.FL22:
+	.quad	0x4000000000000000
+.FL23:
+	.quad	0x4008000000000000
+.FL24:
+	.quad	0x4010000000000000
+.FL25:
+	.quad	0x4014000000000000
+.FL26:
+	.quad	0x4018000000000000
+.FL27:
+	.quad	0x3ff8000000000000
+.FL28:
+	.quad	0x3ff0000000000000
+.FL29:
+	.quad	0x401c000000000000
+.FL30:
+	.quad	0x4020000000000000
+.FL31:
+	.quad	0x4031000000000000
+.FL32:
+	.quad	0x4024000000000000
+.FL33:
+	.quad	0x4028000000000000
+.FL34:
+	.quad	0x402a000000000000
+.FL35:
+	.quad	0x402c000000000000
+.FL36:
+	.quad	0x402e000000000000
+.FL37:
+	.quad	0x4030000000000000
+
+# end of generated code
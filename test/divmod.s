@@ -0,0 +1,740 @@
+# start of generated code
+	.data	
+	.section		.rodata	
+.LC0:
+	.string	"%lld / 2 = %lld, rem %lld\n"
+.LC1:
+	.string	"%lld / 4 = %lld, rem %lld\n"
+.LC2:
+	.string	"%lld / 8 = %lld, rem %lld\n"
+.LC3:
+	.string	"%lld / 16 = %lld, rem %lld\n"
+.LC4:
+	.string	"%lld / 1024 = %lld, rem %lld\n"
+.LC5:
+	.string	"%lld / 2147483648 = %lld, rem %lld\n"
+.LC6:
+	.string	"%lld / 1099511627776 = %lld, rem %lld\n"
+.LC7:
+	.string	"%lld / -2 = %lld, rem %lld\n"
+.LC8:
+	.string	"%lld / -4 = %lld, rem %lld\n"
+.LC9:
+	.string	"%lld / -8 = %lld, rem %lld\n"
+.LC10:
+	.string	"%lld / -16 = %lld, rem %lld\n"
+.LC11:
+	.string	"%lld / -1024 = %lld, rem %lld\n"
+.LC12:
+	.string	"%lld / 3 = %lld, rem %lld\n"
+.LC13:
+	.string	"%lld / -3 = %lld, rem %lld\n"
+.LC14:
+	.string	"%lld / 5 = %lld, rem %lld\n"
+.LC15:
+	.string	"%lld / 7 = %lld, rem %lld\n"
+.LC16:
+	.string	"%lld / -7 = %lld, rem %lld\n"
+.LC17:
+	.string	"%lld / 10 = %lld, rem %lld\n"
+.LC18:
+	.string	"%lld / -10 = %lld, rem %lld\n"
+.LC19:
+	.string	"%lld / 1000003 = %lld, rem %lld\n"
+.LC20:
+	.string	"%lld * -9 = %lld\n"
+.LC21:
+	.string	"%lld * 40 = %lld\n"
+.LC22:
+	.string	"%lld * 7 = %lld\n"
+.LC23:
+	.string	"%lld * 3 = %lld\n"
+.LC24:
+	.string	"%lld * 5 = %lld\n"
+.LC25:
+	.string	"%lld * 9 = %lld\n"
+.LC26:
+	.string	"%lld * -2 = %lld\n"
+.LC27:
+	.string	"%lld * -8 = %lld\n"
+.LC28:
+	.string	"%lld * 0 = %lld\n"
+	.text	
+	.globl	divide
+	.type	divide, @function
+divide:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+	movq	%rdi, -8(%rbp)
+.POS0:
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$63, %rdx
+	addq	%rdx, %rax
+	sarq	$1, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$63, %rdx
+	addq	%rdx, %rax
+	andq	$1, %rax
+	subq	%rdx, %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC0, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$62, %rdx
+	addq	%rdx, %rax
+	sarq	$2, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$62, %rdx
+	addq	%rdx, %rax
+	andq	$3, %rax
+	subq	%rdx, %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC1, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$61, %rdx
+	addq	%rdx, %rax
+	sarq	$3, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$61, %rdx
+	addq	%rdx, %rax
+	andq	$7, %rax
+	subq	%rdx, %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC2, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$60, %rdx
+	addq	%rdx, %rax
+	sarq	$4, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$60, %rdx
+	addq	%rdx, %rax
+	andq	$15, %rax
+	subq	%rdx, %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC3, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$54, %rdx
+	addq	%rdx, %rax
+	sarq	$10, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$54, %rdx
+	addq	%rdx, %rax
+	andq	$1023, %rax
+	subq	%rdx, %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC4, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$33, %rdx
+	addq	%rdx, %rax
+	sarq	$31, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$33, %rdx
+	addq	%rdx, %rax
+	andq	$2147483647, %rax
+	subq	%rdx, %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC5, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$1099511627776, %rcx
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	%rcx
+	movq	%rax, -16(%rbp)
+	movq	$1099511627776, %rcx
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	%rcx
+	movq	%rdx, -24(%rbp)
+	movq	$.LC6, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$0, %rax
+	subq	$2, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rax, -24(%rbp)
+	movq	$0, %rax
+	subq	$2, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rdx, -32(%rbp)
+	movq	$.LC7, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movq	-32(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$0, %rax
+	subq	$4, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rax, -24(%rbp)
+	movq	$0, %rax
+	subq	$4, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rdx, -32(%rbp)
+	movq	$.LC8, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movq	-32(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$0, %rax
+	subq	$8, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rax, -24(%rbp)
+	movq	$0, %rax
+	subq	$8, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rdx, -32(%rbp)
+	movq	$.LC9, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movq	-32(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$0, %rax
+	subq	$16, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rax, -24(%rbp)
+	movq	$0, %rax
+	subq	$16, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rdx, -32(%rbp)
+	movq	$.LC10, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movq	-32(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$0, %rax
+	subq	$1024, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rax, -24(%rbp)
+	movq	$0, %rax
+	subq	$1024, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rdx, -32(%rbp)
+	movq	$.LC11, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movq	-32(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$6148914691236517206, %rax
+	imulq	-8(%rbp)
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, -16(%rbp)
+	movq	$6148914691236517206, %rax
+	imulq	-8(%rbp)
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	imulq	$3, %rdx
+	movq	-8(%rbp), %rax
+	subq	%rdx, %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC12, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$0, %rax
+	subq	$3, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rax, -24(%rbp)
+	movq	$0, %rax
+	subq	$3, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rdx, -32(%rbp)
+	movq	$.LC13, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movq	-32(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$7378697629483820647, %rax
+	imulq	-8(%rbp)
+	sarq	$1, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, -16(%rbp)
+	movq	$7378697629483820647, %rax
+	imulq	-8(%rbp)
+	sarq	$1, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	imulq	$5, %rdx
+	movq	-8(%rbp), %rax
+	subq	%rdx, %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC14, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$5270498306774157605, %rax
+	imulq	-8(%rbp)
+	sarq	$1, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, -16(%rbp)
+	movq	$5270498306774157605, %rax
+	imulq	-8(%rbp)
+	sarq	$1, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	imulq	$7, %rdx
+	movq	-8(%rbp), %rax
+	subq	%rdx, %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC15, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$0, %rax
+	subq	$7, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rax, -24(%rbp)
+	movq	$0, %rax
+	subq	$7, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rdx, -32(%rbp)
+	movq	$.LC16, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movq	-32(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$7378697629483820647, %rax
+	imulq	-8(%rbp)
+	sarq	$2, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, -16(%rbp)
+	movq	$7378697629483820647, %rax
+	imulq	-8(%rbp)
+	sarq	$2, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	imulq	$10, %rdx
+	movq	-8(%rbp), %rax
+	subq	%rdx, %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC17, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$0, %rax
+	subq	$10, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rax, -24(%rbp)
+	movq	$0, %rax
+	subq	$10, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	cqto	
+	idivq	-16(%rbp)
+	movq	%rdx, -32(%rbp)
+	movq	$.LC18, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movq	-32(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+	movq	$-8775366530925146571, %rax
+	imulq	-8(%rbp)
+	addq	-8(%rbp), %rdx
+	sarq	$19, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	movq	%rdx, -16(%rbp)
+	movq	$-8775366530925146571, %rax
+	imulq	-8(%rbp)
+	addq	-8(%rbp), %rdx
+	sarq	$19, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	imulq	$1000003, %rdx
+	movq	-8(%rbp), %rax
+	subq	%rdx, %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC19, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	leave	
+	jmp	printf
+	.size	divide, .-divide
+	.globl	multiply
+	.type	multiply, @function
+multiply:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+	movq	%rdi, -8(%rbp)
+.POS1:
+	movq	$0, %rax
+	subq	$9, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	imulq	-16(%rbp), %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC20, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+	movq	-8(%rbp), %rax
+	leaq	(%rax, %rax, 4), %rax
+	salq	$3, %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC21, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+	movq	-8(%rbp), %rax
+	imulq	$7, %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC22, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+	movq	-8(%rbp), %rax
+	leaq	(%rax, %rax, 2), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC23, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+	movq	-8(%rbp), %rax
+	leaq	(%rax, %rax, 4), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC24, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+	movq	-8(%rbp), %rax
+	leaq	(%rax, %rax, 8), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC25, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+	movq	$0, %rax
+	subq	$2, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	imulq	-16(%rbp), %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC26, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+	movq	$0, %rax
+	subq	$8, %rax
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rax
+	imulq	-16(%rbp), %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC27, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+	movq	$0, %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC28, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movl	$0, %eax
+	leave	
+	jmp	printf
+	.size	multiply, .-multiply
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+.POS2:
+	movq	$9223372036854775807, %rax
+	movq	%rax, -8(%rbp)
+	movq	$0, %rax
+	subq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	subq	$1, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	$0, %rdi
+	call	divide
+	movq	$1, %rdi
+	call	divide
+	movq	$0, %rax
+	subq	$1, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	divide
+	movq	$7, %rdi
+	call	divide
+	movq	$0, %rax
+	subq	$7, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	divide
+	movq	$9, %rdi
+	call	divide
+	movq	$0, %rax
+	subq	$9, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	divide
+	movq	$100, %rdi
+	call	divide
+	movq	$0, %rax
+	subq	$100, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	divide
+	movq	$1023, %rdi
+	call	divide
+	movq	$0, %rax
+	subq	$1023, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	divide
+	movq	$1024, %rdi
+	call	divide
+	movq	$0, %rax
+	subq	$1025, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	divide
+	movq	$123456789, %rdi
+	call	divide
+	movq	$0, %rax
+	subq	$123456789, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	divide
+	movq	-8(%rbp), %rdi
+	call	divide
+	movq	-8(%rbp), %rax
+	subq	$1, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	divide
+	movq	-16(%rbp), %rdi
+	call	divide
+	movq	-16(%rbp), %rax
+	addq	$1, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	divide
+	movq	-16(%rbp), %rax
+	addq	$7, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	divide
+	movq	$0, %rdi
+	call	multiply
+	movq	$1, %rdi
+	call	multiply
+	movq	$0, %rax
+	subq	$1, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	multiply
+	movq	$7, %rdi
+	call	multiply
+	movq	$0, %rax
+	subq	$7, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	multiply
+	movq	$9, %rdi
+	call	multiply
+	movq	$0, %rax
+	subq	$9, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	multiply
+	movq	$100, %rdi
+	call	multiply
+	movq	$0, %rax
+	subq	$100, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	multiply
+	movq	$1023, %rdi
+	call	multiply
+	movq	$0, %rax
+	subq	$1023, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	multiply
+	movq	$1024, %rdi
+	call	multiply
+	movq	$0, %rax
+	subq	$1025, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	multiply
+	movq	$123456789, %rdi
+	call	multiply
+	movq	$0, %rax
+	subq	$123456789, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	multiply
+	movq	-8(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$58, %rdx
+	addq	%rdx, %rax
+	sarq	$6, %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rdi
+	call	multiply
+	movq	-16(%rbp), %rax
+	movq	%rax, %rdx
+	sarq	$63, %rdx
+	shrq	$58, %rdx
+	addq	%rdx, %rax
+	sarq	$6, %rax
+	movq	%rax, -8(%rbp)
+	movq	-8(%rbp), %rdi
+	leave	
+	jmp	multiply
+	.size	main, .-main
+
+# end of generated code
@@ -0,0 +1,72 @@
+# start of generated code
+	.data	
+	.section		.rodata	
+.LC0:
+	.string	"ind(%lld) = %lld \n"
+	.text	
+	.globl	ind
+	.type	ind, @function
+ind:
+	movq	%rdi, -8(%rsp)
+	movq	%rsi, -16(%rsp)
+.POS0:
+	movq	$1, -24(%rsp)
+	movq	-8(%rsp), %rax
+	movq	%rax, -32(%rsp)
+.POS1:
+	cmpq	$1, -32(%rsp)
+	je	.POS3
+.POS2:
+	movq	-32(%rsp), %rax
+	imulq	-8(%rsp), %rax
+	movq	%rax, -40(%rsp)
+	movq	-40(%rsp), %rax
+	cqto	
+	idivq	-16(%rsp)
+	movq	%rdx, -48(%rsp)
+	movq	-48(%rsp), %rax
+	movq	%rax, -32(%rsp)
+	movq	-24(%rsp), %rax
+	addq	$1, %rax
+	movq	%rax, -40(%rsp)
+	movq	-40(%rsp), %rax
+	movq	%rax, -24(%rsp)
+	jmp	.POS1
+.POS3:
+	movq	-24(%rsp), %rax
+	ret	
+	.size	ind, .-ind
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+.POS4:
+	movq	$1, -8(%rbp)
+.POS5:
+	cmpq	$23, -8(%rbp)
+	jge	.POS8
+.POS6:
+	movq	-8(%rbp), %rdi
+	movq	$23, %rsi
+	call	ind
+	movq	%rax, -16(%rbp)
+	movq	$.LC0, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+.POS7:
+	movq	-8(%rbp), %rax
+	addq	$1, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -8(%rbp)
+	jmp	.POS5
+.POS8:
+	leave	
+	ret	
+	.size	main, .-main
+
+# end of generated code
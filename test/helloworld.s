@@ -0,0 +1,16 @@
+# start of generated code
+	.data	
+	.section		.rodata	
+.LC0:
+	.string	"Hello world!"
+	.text	
+	.globl	main
+	.type	main, @function
+main:
+.POS0:
+	movq	$.LC0, %rdi
+	movl	$0, %eax
+	jmp	printf
+	.size	main, .-main
+
+# end of generated code
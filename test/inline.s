@@ -0,0 +1,344 @@
+# start of generated code
+	.data	
+	.globl	count
+	.align	8
+	.type	count, @object
+	.size	count, 8
+count:
+	.quad	0
+	.globl	total
+	.align	8
+	.type	total, @object
+	.size	total, 8
+total:
+	.quad	0
+	.globl	scale
+	.align	8
+	.type	scale, @object
+	.size	scale, 8
+scale:
+	.long	0
+	.long	0
+	.section		.rodata	
+.LC0:
+	.string	"clamp %lld -> %lld, count %lld\n"
+.LC1:
+	.string	"sum_to %lld = %lld, total %lld\n"
+.LC2:
+	.string	"grow %f %f %f\n"
+.LC3:
+	.string	"scale %f\n"
+.LC4:
+	.string	"bump count %lld, total %lld\n"
+	.text	
+	.globl	clamp
+	.type	clamp, @function
+clamp:
+	movq	%rdi, -8(%rsp)
+	movq	%rsi, -16(%rsp)
+	movq	%rdx, -24(%rsp)
+.POS0:
+	movq	count(%rip), %rax
+	movq	%rax, -32(%rsp)
+	movq	-32(%rsp), %rax
+	addq	$1, %rax
+	movq	%rax, -40(%rsp)
+	movq	-40(%rsp), %rax
+	movq	%rax, count(%rip)
+	movq	-8(%rsp), %rax
+	cmpq	-16(%rsp), %rax
+	jge	.POS2
+.POS1:
+	movq	-16(%rsp), %rax
+	ret	
+.POS2:
+.POS3:
+	movq	-8(%rsp), %rax
+	cmpq	-24(%rsp), %rax
+	jle	.POS5
+.POS4:
+	movq	-24(%rsp), %rax
+	ret	
+.POS5:
+.POS6:
+	movq	-8(%rsp), %rax
+	ret	
+	.size	clamp, .-clamp
+	.globl	sum_to
+	.type	sum_to, @function
+sum_to:
+	movq	%rdi, -8(%rsp)
+.POS7:
+	movq	$0, -16(%rsp)
+	movq	$1, -24(%rsp)
+.POS8:
+	movq	-24(%rsp), %rax
+	cmpq	-8(%rsp), %rax
+	jg	.POS11
+.POS9:
+	movq	$6148914691236517206, %rax
+	imulq	-24(%rsp)
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	imulq	$3, %rdx
+	movq	-24(%rsp), %rax
+	subq	%rdx, %rax
+	movq	%rax, -32(%rsp)
+	cmpq	$0, -32(%rsp)
+	je	.POS12
+	jmp	.POS13
+.POS10:
+	movq	-24(%rsp), %rax
+	addq	$1, %rax
+	movq	%rax, -32(%rsp)
+	movq	-32(%rsp), %rax
+	movq	%rax, -24(%rsp)
+	jmp	.POS8
+.POS11:
+	movq	total(%rip), %rax
+	movq	%rax, -32(%rsp)
+	movq	-32(%rsp), %rax
+	addq	-16(%rsp), %rax
+	movq	%rax, -40(%rsp)
+	movq	-40(%rsp), %rax
+	movq	%rax, total(%rip)
+	movq	-16(%rsp), %rax
+	ret	
+.POS12:
+	jmp	.POS10
+.POS13:
+.POS14:
+	movq	-16(%rsp), %rax
+	addq	-24(%rsp), %rax
+	movq	%rax, -32(%rsp)
+	movq	-32(%rsp), %rax
+	movq	%rax, -16(%rsp)
+	cmpq	$1000, -16(%rsp)
+	jle	.POS16
+.POS15:
+	movq	total(%rip), %rax
+	movq	%rax, -32(%rsp)
+	movq	-32(%rsp), %rax
+	addq	-16(%rsp), %rax
+	movq	%rax, -40(%rsp)
+	movq	-40(%rsp), %rax
+	movq	%rax, total(%rip)
+	movq	$0, %rax
+	subq	-24(%rsp), %rax
+	movq	%rax, -32(%rsp)
+	movq	-32(%rsp), %rax
+	ret	
+.POS16:
+.POS17:
+	jmp	.POS10
+	.size	sum_to, .-sum_to
+	.globl	grow
+	.type	grow, @function
+grow:
+	movsd	%xmm0, -8(%rsp)
+.POS18:
+	movq	scale(%rip), %rax
+	movq	%rax, -16(%rsp)
+	movsd	-16(%rsp), %xmm5
+	mulsd	.FL5(%rip), %xmm5
+	movsd	%xmm5, -24(%rsp)
+	movq	-24(%rsp), %rax
+	movq	%rax, scale(%rip)
+	movsd	.FL6(%rip), %xmm5
+	ucomisd	-8(%rsp), %xmm5
+	jbe	.POS20
+.POS19:
+	movq	scale(%rip), %rax
+	movq	%rax, -16(%rsp)
+	movsd	-8(%rsp), %xmm5
+	mulsd	-16(%rsp), %xmm5
+	movsd	%xmm5, -24(%rsp)
+	movsd	.FL6(%rip), %xmm5
+	subsd	-24(%rsp), %xmm5
+	movsd	%xmm5, -16(%rsp)
+	movq	-16(%rsp), %rax
+	ret	
+.POS20:
+.POS21:
+	movq	scale(%rip), %rax
+	movq	%rax, -16(%rsp)
+	movsd	-8(%rsp), %xmm5
+	mulsd	-16(%rsp), %xmm5
+	movsd	%xmm5, -24(%rsp)
+	movq	-24(%rsp), %rax
+	ret	
+	.size	grow, .-grow
+	.globl	bump
+	.type	bump, @function
+bump:
+.POS22:
+	movq	count(%rip), %rax
+	movq	%rax, -8(%rsp)
+	movq	-8(%rsp), %rax
+	addq	$10, %rax
+	movq	%rax, -16(%rsp)
+	movq	-16(%rsp), %rax
+	movq	%rax, count(%rip)
+	movq	count(%rip), %rax
+	movq	%rax, -8(%rsp)
+	cmpq	$40, -8(%rsp)
+	jle	.POS24
+.POS23:
+	ret	
+.POS24:
+.POS25:
+	movq	total(%rip), %rax
+	movq	%rax, -8(%rsp)
+	movq	-8(%rsp), %rax
+	addq	$1, %rax
+	movq	%rax, -16(%rsp)
+	movq	-16(%rsp), %rax
+	movq	%rax, total(%rip)
+	ret	
+	.size	bump, .-bump
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$48, %rsp
+.POS26:
+	movq	$0, count(%rip)
+	movq	$0, total(%rip)
+	movq	.FL7(%rip), %rax
+	movq	%rax, scale(%rip)
+	movq	$0, %rax
+	subq	$3, %rax
+	movq	%rax, -8(%rbp)
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+.POS27:
+	cmpq	$14, -16(%rbp)
+	jge	.POS30
+.POS28:
+	movq	-16(%rbp), %rdi
+	movq	$0, %rsi
+	movq	$8, %rdx
+	call	clamp
+	movq	%rax, -8(%rbp)
+	movq	-16(%rbp), %rax
+	salq	$1, %rax
+	movq	%rax, -24(%rbp)
+	movq	$0, %rax
+	subq	$1, %rax
+	movq	%rax, -32(%rbp)
+	movq	-24(%rbp), %rdi
+	movq	-32(%rbp), %rsi
+	movq	$5, %rdx
+	call	clamp
+	movq	%rax, -40(%rbp)
+	movq	-8(%rbp), %rax
+	addq	-40(%rbp), %rax
+	movq	%rax, -24(%rbp)
+	movq	-24(%rbp), %rax
+	movq	%rax, -8(%rbp)
+	movq	count(%rip), %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC0, %rdi
+	movq	-16(%rbp), %rsi
+	movq	-8(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+.POS29:
+	movq	-16(%rbp), %rax
+	addq	$4, %rax
+	movq	%rax, -8(%rbp)
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	jmp	.POS27
+.POS30:
+	movq	$0, -16(%rbp)
+.POS31:
+	cmpq	$90, -16(%rbp)
+	jge	.POS34
+.POS32:
+	movq	-16(%rbp), %rdi
+	call	sum_to
+	movq	%rax, -8(%rbp)
+	movq	total(%rip), %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC1, %rdi
+	movq	-16(%rbp), %rsi
+	movq	-8(%rbp), %rdx
+	movq	-24(%rbp), %rcx
+	movl	$0, %eax
+	call	printf
+.POS33:
+	movq	-16(%rbp), %rax
+	addq	$15, %rax
+	movq	%rax, -8(%rbp)
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	jmp	.POS31
+.POS34:
+	movsd	.FL8(%rip), %xmm0
+	call	grow
+	movq	%rax, -8(%rbp)
+	movsd	.FL6(%rip), %xmm5
+	subsd	.FL5(%rip), %xmm5
+	movsd	%xmm5, -24(%rbp)
+	movsd	-24(%rbp), %xmm0
+	call	grow
+	movq	%rax, -32(%rbp)
+	movsd	.FL9(%rip), %xmm0
+	call	grow
+	movq	%rax, -24(%rbp)
+	movq	$.LC2, %rdi
+	movsd	-8(%rbp), %xmm0
+	movsd	-32(%rbp), %xmm1
+	movsd	-24(%rbp), %xmm2
+	movl	$3, %eax
+	call	printf
+	movq	scale(%rip), %rax
+	movq	%rax, -8(%rbp)
+	movq	$.LC3, %rdi
+	movsd	-8(%rbp), %xmm0
+	movl	$1, %eax
+	call	printf
+	movq	$0, -16(%rbp)
+.POS35:
+	cmpq	$4, -16(%rbp)
+	jge	.POS38
+.POS36:
+	call	bump
+	movq	count(%rip), %rax
+	movq	%rax, -8(%rbp)
+	movq	total(%rip), %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC4, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+.POS37:
+	movq	-16(%rbp), %rax
+	addq	$1, %rax
+	movq	%rax, -8(%rbp)
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	jmp	.POS35
+.POS38:
+	leave	
+	ret	
+	.size	main, .-main
+	.section		.rodata	
+	.align	8
+.FL5:
+	.quad	0x4000000000000000
+.FL6:
+	.quad	0x0000000000000000
+.FL7:
+	.quad	0x3fe0000000000000
+.FL8:
+	.quad	0x3ff8000000000000
+.FL9:
+	.quad	0x4008000000000000
+
+# end of generated code
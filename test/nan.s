@@ -0,0 +1,261 @@
+# start of generated code
+	.data	
+	.globl	zero
+	.align	8
+	.type	zero, @object
+	.size	zero, 8
+zero:
+	.long	0
+	.long	0
+	.section		.rodata	
+.LC0:
+	.string	"%s true\n"
+.LC1:
+	.string	"%s false\n"
+.LC2:
+	.string	"n == n"
+.LC3:
+	.string	"n != n"
+.LC4:
+	.string	"n < 1.0"
+.LC5:
+	.string	"n >= 1.0"
+.LC6:
+	.string	"n > 1.0"
+.LC7:
+	.string	"n <= 1.0"
+.LC8:
+	.string	"if n == n\n"
+.LC9:
+	.string	"else n == n\n"
+.LC10:
+	.string	"if n != n\n"
+.LC11:
+	.string	"else n != n\n"
+.LC12:
+	.string	"if n < 1.0\n"
+.LC13:
+	.string	"else n < 1.0\n"
+.LC14:
+	.string	"if n >= 1.0\n"
+.LC15:
+	.string	"else n >= 1.0\n"
+.LC16:
+	.string	"if !(n == n)\n"
+	.text	
+	.globl	show
+	.type	show, @function
+show:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+	movq	%rdi, -8(%rbp)
+	movq	%rsi, -16(%rbp)
+.POS0:
+	cmpq	$0, -16(%rbp)
+	jz	.POS2
+.POS1:
+	movq	$.LC0, %rdi
+	movq	-8(%rbp), %rsi
+	movl	$0, %eax
+	call	printf
+	jmp	.POS3
+.POS2:
+	movq	$.LC1, %rdi
+	movq	-8(%rbp), %rsi
+	movl	$0, %eax
+	call	printf
+.POS3:
+	leave	
+	ret	
+	.size	show, .-show
+	.globl	check
+	.type	check, @function
+check:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+	movsd	%xmm0, -8(%rbp)
+.POS4:
+	movsd	-8(%rbp), %xmm5
+	ucomisd	-8(%rbp), %xmm5
+	sete	%al
+	setnp	%cl
+	andb	%cl, %al
+	movzbq	%al, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC2, %rdi
+	movq	-24(%rbp), %rsi
+	call	show
+	movsd	-8(%rbp), %xmm5
+	ucomisd	-8(%rbp), %xmm5
+	setne	%al
+	setp	%cl
+	orb	%cl, %al
+	movzbq	%al, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC3, %rdi
+	movq	-24(%rbp), %rsi
+	call	show
+	movsd	.FL3(%rip), %xmm5
+	ucomisd	-8(%rbp), %xmm5
+	seta	%al
+	movzbq	%al, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC4, %rdi
+	movq	-24(%rbp), %rsi
+	call	show
+	movsd	-8(%rbp), %xmm5
+	ucomisd	.FL3(%rip), %xmm5
+	setae	%al
+	movzbq	%al, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC5, %rdi
+	movq	-24(%rbp), %rsi
+	call	show
+	movsd	-8(%rbp), %xmm5
+	ucomisd	.FL3(%rip), %xmm5
+	seta	%al
+	movzbq	%al, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC6, %rdi
+	movq	-24(%rbp), %rsi
+	call	show
+	movsd	.FL3(%rip), %xmm5
+	ucomisd	-8(%rbp), %xmm5
+	setae	%al
+	movzbq	%al, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -24(%rbp)
+	movq	$.LC7, %rdi
+	movq	-24(%rbp), %rsi
+	call	show
+	movsd	-8(%rbp), %xmm5
+	ucomisd	-8(%rbp), %xmm5
+	jp	.POS6
+	jne	.POS6
+.POS5:
+	movq	$.LC8, %rdi
+	movl	$0, %eax
+	call	printf
+	jmp	.POS7
+.POS6:
+	movq	$.LC9, %rdi
+	movl	$0, %eax
+	call	printf
+.POS7:
+	movsd	-8(%rbp), %xmm5
+	ucomisd	-8(%rbp), %xmm5
+	jp	.POS8
+	je	.POS9
+.POS8:
+	movq	$.LC10, %rdi
+	movl	$0, %eax
+	call	printf
+	jmp	.POS10
+.POS9:
+	movq	$.LC11, %rdi
+	movl	$0, %eax
+	call	printf
+.POS10:
+	movsd	.FL3(%rip), %xmm5
+	ucomisd	-8(%rbp), %xmm5
+	jbe	.POS12
+.POS11:
+	movq	$.LC12, %rdi
+	movl	$0, %eax
+	call	printf
+	jmp	.POS13
+.POS12:
+	movq	$.LC13, %rdi
+	movl	$0, %eax
+	call	printf
+.POS13:
+	movsd	-8(%rbp), %xmm5
+	ucomisd	.FL3(%rip), %xmm5
+	jb	.POS15
+.POS14:
+	movq	$.LC14, %rdi
+	movl	$0, %eax
+	call	printf
+	jmp	.POS16
+.POS15:
+	movq	$.LC15, %rdi
+	movl	$0, %eax
+	call	printf
+.POS16:
+	movsd	-8(%rbp), %xmm5
+	ucomisd	-8(%rbp), %xmm5
+	jp	.POS17
+	je	.POS18
+.POS17:
+	movq	$.LC16, %rdi
+	movl	$0, %eax
+	call	printf
+	jmp	.POS19
+.POS18:
+.POS19:
+	leave	
+	ret	
+	.size	check, .-check
+	.globl	nan_of
+	.type	nan_of, @function
+nan_of:
+	movsd	%xmm0, -8(%rsp)
+.POS20:
+	movsd	-8(%rsp), %xmm5
+	divsd	-8(%rsp), %xmm5
+	movsd	%xmm5, -16(%rsp)
+	movq	-16(%rsp), %rax
+	ret	
+	.size	nan_of, .-nan_of
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+.POS21:
+	movq	.FL4(%rip), %rax
+	movq	%rax, zero(%rip)
+	movq	zero(%rip), %rax
+	movq	%rax, -8(%rbp)
+	movq	zero(%rip), %rax
+	movq	%rax, -16(%rbp)
+	movsd	-8(%rbp), %xmm5
+	divsd	-16(%rbp), %xmm5
+	movsd	%xmm5, -24(%rbp)
+	movq	-24(%rbp), %rax
+	movq	%rax, -8(%rbp)
+	movsd	-8(%rbp), %xmm0
+	call	check
+	movsd	.FL4(%rip), %xmm0
+	call	nan_of
+	movq	%rax, -8(%rbp)
+	movsd	-8(%rbp), %xmm0
+	call	check
+	movsd	.FL5(%rip), %xmm0
+	leave	
+	jmp	check
+	.size	main, .-main
+	.section		.rodata	
+	.align	8
+.FL3:
+	.quad	0x3ff0000000000000
+.FL4:
+	.quad	0x0000000000000000
+.FL5:
+	.quad	0x3fe0000000000000
+
+# end of generated code
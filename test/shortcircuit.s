@@ -0,0 +1,554 @@
+# start of generated code
+	.data	
+	.globl	trace
+	.align	8
+	.type	trace, @object
+	.size	trace, 8
+trace:
+	.quad	0
+	.section		.rodata	
+.LC0:
+	.string	"%s: true, trace %lld\n"
+.LC1:
+	.string	"%s: false, trace %lld\n"
+.LC2:
+	.string	"f && t"
+.LC3:
+	.string	"t && f"
+.LC4:
+	.string	"t && t"
+.LC5:
+	.string	"t || f"
+.LC6:
+	.string	"f || t"
+.LC7:
+	.string	"f || f"
+.LC8:
+	.string	"!t && t"
+.LC9:
+	.string	"!f || t"
+.LC10:
+	.string	"!(f || f) && (t || t)"
+.LC11:
+	.string	"(f && t) || (t && f) || t"
+.LC12:
+	.string	"if f && t\n"
+.LC13:
+	.string	"cond f && t"
+.LC14:
+	.string	"if t || t\n"
+.LC15:
+	.string	"cond t || t"
+.LC16:
+	.string	"if !(t && f) || t\n"
+.LC17:
+	.string	"cond !(t && f) || t"
+.LC18:
+	.string	"if !t || (f && t)\n"
+.LC19:
+	.string	"else !t || (f && t)\n"
+.LC20:
+	.string	"cond !t || (f && t)"
+.LC21:
+	.string	"never\n"
+.LC22:
+	.string	"while t && f"
+.LC23:
+	.string	"%lld\n"
+	.text	
+	.globl	t
+	.type	t, @function
+t:
+	movq	%rdi, -8(%rsp)
+.POS0:
+	movq	trace(%rip), %rax
+	movq	%rax, -16(%rsp)
+	movq	-16(%rsp), %rax
+	leaq	(%rax, %rax, 4), %rax
+	salq	$1, %rax
+	movq	%rax, -24(%rsp)
+	movq	-24(%rsp), %rax
+	addq	-8(%rsp), %rax
+	movq	%rax, -16(%rsp)
+	movq	-16(%rsp), %rax
+	movq	%rax, trace(%rip)
+	movq	$1, %rax
+	ret	
+	.size	t, .-t
+	.globl	f
+	.type	f, @function
+f:
+	movq	%rdi, -8(%rsp)
+.POS1:
+	movq	trace(%rip), %rax
+	movq	%rax, -16(%rsp)
+	movq	-16(%rsp), %rax
+	leaq	(%rax, %rax, 4), %rax
+	salq	$1, %rax
+	movq	%rax, -24(%rsp)
+	movq	-24(%rsp), %rax
+	addq	-8(%rsp), %rax
+	movq	%rax, -16(%rsp)
+	movq	-16(%rsp), %rax
+	movq	%rax, trace(%rip)
+	movq	$0, %rax
+	ret	
+	.size	f, .-f
+	.globl	report
+	.type	report, @function
+report:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+	movq	%rdi, -8(%rbp)
+	movq	%rsi, -16(%rbp)
+.POS2:
+	cmpq	$0, -16(%rbp)
+	jz	.POS4
+.POS3:
+	movq	trace(%rip), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC0, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+	jmp	.POS5
+.POS4:
+	movq	trace(%rip), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC1, %rdi
+	movq	-8(%rbp), %rsi
+	movq	-16(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+.POS5:
+	movq	$0, trace(%rip)
+	leave	
+	ret	
+	.size	report, .-report
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+.POS6:
+	movq	$0, trace(%rip)
+	movq	$1, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS10
+	jmp	.POS8
+.POS7:
+	movq	$1, -8(%rbp)
+	jmp	.POS9
+.POS8:
+	movq	$0, -8(%rbp)
+.POS9:
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC2, %rdi
+	movq	-16(%rbp), %rsi
+	call	report
+	movq	$1, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS14
+	jmp	.POS12
+.POS10:
+	movq	$2, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS7
+	jmp	.POS8
+.POS11:
+	movq	$1, -8(%rbp)
+	jmp	.POS13
+.POS12:
+	movq	$0, -8(%rbp)
+.POS13:
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC3, %rdi
+	movq	-16(%rbp), %rsi
+	call	report
+	movq	$1, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS18
+	jmp	.POS16
+.POS14:
+	movq	$2, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS11
+	jmp	.POS12
+.POS15:
+	movq	$1, -8(%rbp)
+	jmp	.POS17
+.POS16:
+	movq	$0, -8(%rbp)
+.POS17:
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC4, %rdi
+	movq	-16(%rbp), %rsi
+	call	report
+	movq	$1, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS19
+	jmp	.POS22
+.POS18:
+	movq	$2, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS15
+	jmp	.POS16
+.POS19:
+	movq	$1, -8(%rbp)
+	jmp	.POS21
+.POS20:
+	movq	$0, -8(%rbp)
+.POS21:
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC5, %rdi
+	movq	-16(%rbp), %rsi
+	call	report
+	movq	$1, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS23
+	jmp	.POS26
+.POS22:
+	movq	$2, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS19
+	jmp	.POS20
+.POS23:
+	movq	$1, -8(%rbp)
+	jmp	.POS25
+.POS24:
+	movq	$0, -8(%rbp)
+.POS25:
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC6, %rdi
+	movq	-16(%rbp), %rsi
+	call	report
+	movq	$1, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS27
+	jmp	.POS30
+.POS26:
+	movq	$2, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS23
+	jmp	.POS24
+.POS27:
+	movq	$1, -8(%rbp)
+	jmp	.POS29
+.POS28:
+	movq	$0, -8(%rbp)
+.POS29:
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC7, %rdi
+	movq	-16(%rbp), %rsi
+	call	report
+	movq	$1, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS32
+	jmp	.POS34
+.POS30:
+	movq	$2, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS27
+	jmp	.POS28
+.POS31:
+	movq	$1, -8(%rbp)
+	jmp	.POS33
+.POS32:
+	movq	$0, -8(%rbp)
+.POS33:
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC8, %rdi
+	movq	-16(%rbp), %rsi
+	call	report
+	movq	$1, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS38
+	jmp	.POS35
+.POS34:
+	movq	$2, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS31
+	jmp	.POS32
+.POS35:
+	movq	$1, -8(%rbp)
+	jmp	.POS37
+.POS36:
+	movq	$0, -8(%rbp)
+.POS37:
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC9, %rdi
+	movq	-16(%rbp), %rsi
+	call	report
+	movq	$1, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS40
+	jmp	.POS43
+.POS38:
+	movq	$2, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS35
+	jmp	.POS36
+.POS39:
+	movq	$1, -8(%rbp)
+	jmp	.POS41
+.POS40:
+	movq	$0, -8(%rbp)
+.POS41:
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC10, %rdi
+	movq	-16(%rbp), %rsi
+	call	report
+	movq	$1, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS49
+	jmp	.POS48
+.POS42:
+	movq	$3, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS39
+	jmp	.POS44
+.POS43:
+	movq	$2, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS40
+	jmp	.POS42
+.POS44:
+	movq	$4, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS39
+	jmp	.POS40
+.POS45:
+	movq	$1, -8(%rbp)
+	jmp	.POS47
+.POS46:
+	movq	$0, -8(%rbp)
+.POS47:
+	movq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC11, %rdi
+	movq	-16(%rbp), %rsi
+	call	report
+	movq	$1, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS55
+	jmp	.POS53
+.POS48:
+	movq	$3, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS51
+	jmp	.POS50
+.POS49:
+	movq	$2, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS45
+	jmp	.POS48
+.POS50:
+	movq	$5, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS45
+	jmp	.POS46
+.POS51:
+	movq	$4, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS45
+	jmp	.POS50
+.POS52:
+	movq	$.LC12, %rdi
+	movl	$0, %eax
+	call	printf
+	jmp	.POS54
+.POS53:
+.POS54:
+	movq	$.LC13, %rdi
+	movq	$0, %rsi
+	call	report
+	movq	$1, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS56
+	jmp	.POS59
+.POS55:
+	movq	$2, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS52
+	jmp	.POS53
+.POS56:
+	movq	$.LC14, %rdi
+	movl	$0, %eax
+	call	printf
+	jmp	.POS58
+.POS57:
+.POS58:
+	movq	$.LC15, %rdi
+	movq	$1, %rsi
+	call	report
+	movq	$1, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS64
+	jmp	.POS60
+.POS59:
+	movq	$2, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS56
+	jmp	.POS57
+.POS60:
+	movq	$.LC16, %rdi
+	movl	$0, %eax
+	call	printf
+	jmp	.POS62
+.POS61:
+.POS62:
+	movq	$.LC17, %rdi
+	movq	$1, %rsi
+	call	report
+	movq	$1, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS68
+	jmp	.POS65
+.POS63:
+	movq	$3, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS60
+	jmp	.POS61
+.POS64:
+	movq	$2, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS63
+	jmp	.POS60
+.POS65:
+	movq	$.LC18, %rdi
+	movl	$0, %eax
+	call	printf
+	jmp	.POS67
+.POS66:
+	movq	$.LC19, %rdi
+	movl	$0, %eax
+	call	printf
+.POS67:
+	movq	$.LC20, %rdi
+	movq	$0, %rsi
+	call	report
+	jmp	.POS70
+.POS68:
+	movq	$2, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jz	.POS66
+.POS69:
+	movq	$3, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS65
+	jmp	.POS66
+.POS70:
+	movq	$1, %rdi
+	call	t
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS73
+	jmp	.POS72
+.POS71:
+	movq	$.LC21, %rdi
+	movl	$0, %eax
+	call	printf
+	jmp	.POS70
+.POS72:
+	movq	$.LC22, %rdi
+	movq	$0, %rsi
+	call	report
+	movq	trace(%rip), %rax
+	movq	%rax, -8(%rbp)
+	movq	$.LC23, %rdi
+	movq	-8(%rbp), %rsi
+	movl	$0, %eax
+	leave	
+	jmp	printf
+.POS73:
+	movq	$2, %rdi
+	call	f
+	movq	%rax, -8(%rbp)
+	cmpq	$0, -8(%rbp)
+	jnz	.POS71
+	jmp	.POS72
+	.size	main, .-main
+
+# end of generated code
@@ -0,0 +1,214 @@
+# start of generated code
+	.data	
+	.globl	calls
+	.align	8
+	.type	calls, @object
+	.size	calls, 8
+calls:
+	.quad	0
+	.section		.rodata	
+.LC0:
+	.string	"sum %lld\n"
+.LC1:
+	.string	"ping %lld\n"
+.LC2:
+	.string	"calls %lld\n"
+.LC3:
+	.string	"pong %lld\n"
+.LC4:
+	.string	"half %f\n"
+	.text	
+	.globl	sum
+	.type	sum, @function
+sum:
+	movq	%rdi, -8(%rsp)
+	movq	%rsi, -16(%rsp)
+.POS0:
+	cmpq	$0, -8(%rsp)
+	jne	.POS2
+.POS1:
+	movq	-16(%rsp), %rax
+	ret	
+.POS2:
+.POS3:
+	movq	-8(%rsp), %rax
+	subq	$1, %rax
+	movq	%rax, -24(%rsp)
+	movq	-16(%rsp), %rax
+	addq	-8(%rsp), %rax
+	movq	%rax, -32(%rsp)
+	movq	-24(%rsp), %rax
+	movq	%rax, -40(%rsp)
+	movq	-32(%rsp), %rax
+	movq	%rax, -24(%rsp)
+	movq	-40(%rsp), %rax
+	movq	%rax, -8(%rsp)
+	movq	-24(%rsp), %rax
+	movq	%rax, -16(%rsp)
+	jmp	.POS0
+	.size	sum, .-sum
+	.globl	pong
+	.type	pong, @function
+pong:
+	movq	%rdi, -8(%rsp)
+	movq	%rsi, -16(%rsp)
+.POS4:
+	movq	calls(%rip), %rax
+	movq	%rax, -24(%rsp)
+	movq	-24(%rsp), %rax
+	addq	$1, %rax
+	movq	%rax, -32(%rsp)
+	movq	-32(%rsp), %rax
+	movq	%rax, calls(%rip)
+	cmpq	$0, -8(%rsp)
+	jne	.POS6
+.POS5:
+	movq	-16(%rsp), %rax
+	ret	
+.POS6:
+.POS7:
+	movq	-8(%rsp), %rax
+	subq	$1, %rax
+	movq	%rax, -24(%rsp)
+	movq	-16(%rsp), %rax
+	leaq	(%rax, %rax, 2), %rax
+	movq	%rax, -8(%rsp)
+	movq	$-8775366530925146571, %rax
+	imulq	-8(%rsp)
+	addq	-8(%rsp), %rdx
+	sarq	$19, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	imulq	$1000003, %rdx
+	movq	-8(%rsp), %rax
+	subq	%rdx, %rax
+	movq	%rax, -16(%rsp)
+	movq	-24(%rsp), %rdi
+	movq	-16(%rsp), %rsi
+	movq	$2, %rdx
+	jmp	ping
+	.size	pong, .-pong
+	.globl	ping
+	.type	ping, @function
+ping:
+	movq	%rdi, -8(%rsp)
+	movq	%rsi, -16(%rsp)
+	movq	%rdx, -24(%rsp)
+.POS8:
+	cmpq	$0, -8(%rsp)
+	jne	.POS10
+.POS9:
+	movq	-16(%rsp), %rax
+	ret	
+.POS10:
+.POS11:
+	movq	-8(%rsp), %rax
+	subq	$1, %rax
+	movq	%rax, -32(%rsp)
+	movq	-16(%rsp), %rax
+	addq	-24(%rsp), %rax
+	movq	%rax, -8(%rsp)
+	movq	-32(%rsp), %rdi
+	movq	-8(%rsp), %rsi
+	jmp	pong
+	.size	ping, .-ping
+	.globl	scale
+	.type	scale, @function
+scale:
+	movsd	%xmm0, -8(%rsp)
+	movq	%rdi, -16(%rsp)
+	movsd	%xmm1, -24(%rsp)
+.POS12:
+	cmpq	$0, -16(%rsp)
+	jne	.POS14
+.POS13:
+	movq	-8(%rsp), %rax
+	ret	
+.POS14:
+.POS15:
+	movsd	-8(%rsp), %xmm5
+	mulsd	-24(%rsp), %xmm5
+	movsd	%xmm5, -32(%rsp)
+	movq	-16(%rsp), %rax
+	subq	$1, %rax
+	movq	%rax, -40(%rsp)
+	movq	-32(%rsp), %rax
+	movq	%rax, -48(%rsp)
+	movq	-40(%rsp), %rax
+	movq	%rax, -32(%rsp)
+	movq	-24(%rsp), %rax
+	movq	%rax, -40(%rsp)
+	movq	-48(%rsp), %rax
+	movq	%rax, -8(%rsp)
+	movq	-32(%rsp), %rax
+	movq	%rax, -16(%rsp)
+	movq	-40(%rsp), %rax
+	movq	%rax, -24(%rsp)
+	jmp	.POS12
+	.size	scale, .-scale
+	.globl	half
+	.type	half, @function
+half:
+	movsd	%xmm0, -8(%rsp)
+.POS16:
+	movsd	-8(%rsp), %xmm0
+	movq	$3, %rdi
+	movsd	.FL2(%rip), %xmm1
+	jmp	scale
+	.size	half, .-half
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$16, %rsp
+.POS17:
+	movq	$1000000, %rdi
+	movq	$0, %rsi
+	call	sum
+	movq	%rax, -8(%rbp)
+	movq	$.LC0, %rdi
+	movq	-8(%rbp), %rsi
+	movl	$0, %eax
+	call	printf
+	movq	$1000001, %rdi
+	movq	$1, %rsi
+	movq	$5, %rdx
+	call	ping
+	movq	%rax, -8(%rbp)
+	movq	$.LC1, %rdi
+	movq	-8(%rbp), %rsi
+	movl	$0, %eax
+	call	printf
+	movq	calls(%rip), %rax
+	movq	%rax, -8(%rbp)
+	movq	$.LC2, %rdi
+	movq	-8(%rbp), %rsi
+	movl	$0, %eax
+	call	printf
+	movq	$7, %rdi
+	movq	$1, %rsi
+	call	pong
+	movq	%rax, -8(%rbp)
+	movq	$.LC3, %rdi
+	movq	-8(%rbp), %rsi
+	movl	$0, %eax
+	call	printf
+	movsd	.FL3(%rip), %xmm0
+	call	half
+	movq	%rax, -8(%rbp)
+	movq	$.LC4, %rdi
+	movsd	-8(%rbp), %xmm0
+	movl	$1, %eax
+	leave	
+	jmp	printf
+	.size	main, .-main
+	.section		.rodata	
+	.align	8
+.FL2:
+	.quad	0x3fe0000000000000
+.FL3:
+	.quad	0x4034000000000000
+
+# end of generated code
@@ -0,0 +1,74 @@
+# start of generated code
+	.data	
+	.section		.rodata	
+.LC0:
+	.string	"tan = %f\n"
+	.text	
+	.globl	tan
+	.type	tan, @function
+tan:
+	movsd	%xmm0, -8(%rsp)
+	movsd	%xmm1, -16(%rsp)
+	movsd	%xmm2, -24(%rsp)
+	movsd	%xmm3, -32(%rsp)
+.POS0:
+	movsd	-8(%rsp), %xmm5
+	ucomisd	-24(%rsp), %xmm5
+	jp	.POS2
+	jne	.POS2
+.POS1:
+	movq	.FL4(%rip), %rax
+	ret	
+.POS2:
+.POS3:
+	movsd	-32(%rsp), %xmm5
+	subsd	-16(%rsp), %xmm5
+	movsd	%xmm5, -40(%rsp)
+	movsd	-24(%rsp), %xmm5
+	subsd	-8(%rsp), %xmm5
+	movsd	%xmm5, -16(%rsp)
+	movsd	-40(%rsp), %xmm5
+	divsd	-16(%rsp), %xmm5
+	movsd	%xmm5, -8(%rsp)
+	movq	-8(%rsp), %rax
+	ret	
+	.size	tan, .-tan
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$48, %rsp
+.POS4:
+	movq	.FL5(%rip), %rax
+	movq	%rax, -8(%rbp)
+	movq	.FL5(%rip), %rax
+	movq	%rax, -16(%rbp)
+	movq	.FL6(%rip), %rax
+	movq	%rax, -24(%rbp)
+	movq	.FL7(%rip), %rax
+	movq	%rax, -32(%rbp)
+	movsd	-8(%rbp), %xmm0
+	movsd	-16(%rbp), %xmm1
+	movsd	-24(%rbp), %xmm2
+	movsd	-32(%rbp), %xmm3
+	call	tan
+	movq	%rax, -40(%rbp)
+	movq	$.LC0, %rdi
+	movsd	-40(%rbp), %xmm0
+	movl	$1, %eax
+	leave	
+	jmp	printf
+	.size	main, .-main
+	.section		.rodata	
+	.align	8
+.FL4:
+	.quad	0x0000000000000000
+.FL5:
+	.quad	0x400c000000000000
+.FL6:
+	.quad	0x4016000000000000
+.FL7:
+	.quad	0x4012000000000000
+
+# end of generated code
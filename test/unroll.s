@@ -0,0 +1,167 @@
+# start of generated code
+	.data	
+	.section		.rodata	
+.LC0:
+	.string	"i=%lld\n"
+.LC1:
+	.string	"%lld "
+.LC2:
+	.string	"\n"
+.LC3:
+	.string	"%lld %lld\n"
+	.text	
+	.globl	count
+	.type	count, @function
+count:
+	movq	%rdi, -8(%rsp)
+.POS0:
+	movq	$0, -16(%rsp)
+	movq	$0, -24(%rsp)
+.POS1:
+	movq	-24(%rsp), %rax
+	cmpq	-8(%rsp), %rax
+	jge	.POS4
+.POS2:
+	movq	-16(%rsp), %rax
+	leaq	(%rax, %rax, 2), %rax
+	movq	%rax, -32(%rsp)
+	movq	$5270498306774157605, %rax
+	imulq	-24(%rsp)
+	sarq	$1, %rdx
+	movq	%rdx, %rax
+	shrq	$63, %rax
+	addq	%rax, %rdx
+	imulq	$7, %rdx
+	movq	-24(%rsp), %rax
+	subq	%rdx, %rax
+	movq	%rax, -40(%rsp)
+	movq	-32(%rsp), %rax
+	addq	-40(%rsp), %rax
+	movq	%rax, -48(%rsp)
+	movq	-48(%rsp), %rax
+	movq	%rax, -16(%rsp)
+.POS3:
+	movq	-24(%rsp), %rax
+	addq	$1, %rax
+	movq	%rax, -32(%rsp)
+	movq	-32(%rsp), %rax
+	movq	%rax, -24(%rsp)
+	jmp	.POS1
+.POS4:
+	movq	-16(%rsp), %rax
+	ret	
+	.size	count, .-count
+	.globl	shrink
+	.type	shrink, @function
+shrink:
+	movq	%rdi, -8(%rsp)
+.POS5:
+	movq	$0, -16(%rsp)
+	movq	$0, -24(%rsp)
+.POS6:
+	movq	-24(%rsp), %rax
+	cmpq	-8(%rsp), %rax
+	jge	.POS9
+.POS7:
+	movq	-8(%rsp), %rax
+	subq	$1, %rax
+	movq	%rax, -32(%rsp)
+	movq	-32(%rsp), %rax
+	movq	%rax, -8(%rsp)
+	movq	-16(%rsp), %rax
+	addq	-24(%rsp), %rax
+	movq	%rax, -32(%rsp)
+	movq	-32(%rsp), %rax
+	movq	%rax, -16(%rsp)
+.POS8:
+	movq	-24(%rsp), %rax
+	addq	$1, %rax
+	movq	%rax, -32(%rsp)
+	movq	-32(%rsp), %rax
+	movq	%rax, -24(%rsp)
+	jmp	.POS6
+.POS9:
+	movq	-16(%rsp), %rax
+	ret	
+	.size	shrink, .-shrink
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+.POS10:
+	movq	$2, -8(%rbp)
+.POS11:
+	cmpq	$8, -8(%rbp)
+	jge	.POS14
+.POS12:
+	movq	-8(%rbp), %rax
+	addq	$1, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -8(%rbp)
+	movq	$.LC0, %rdi
+	movq	-8(%rbp), %rsi
+	movl	$0, %eax
+	call	printf
+.POS13:
+	movq	-8(%rbp), %rax
+	addq	$1, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -8(%rbp)
+	jmp	.POS11
+.POS14:
+	movq	$1, -8(%rbp)
+.POS15:
+	cmpq	$15, -8(%rbp)
+	jge	.POS18
+.POS16:
+	movq	-8(%rbp), %rax
+	imulq	-8(%rbp), %rax
+	movq	%rax, -16(%rbp)
+	movq	$.LC1, %rdi
+	movq	-16(%rbp), %rsi
+	movl	$0, %eax
+	call	printf
+.POS17:
+	movq	-8(%rbp), %rax
+	addq	$1, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -8(%rbp)
+	jmp	.POS15
+.POS18:
+	movq	$.LC2, %rdi
+	movl	$0, %eax
+	call	printf
+	movq	$0, -8(%rbp)
+.POS19:
+	cmpq	$10, -8(%rbp)
+	jge	.POS22
+.POS20:
+	movq	-8(%rbp), %rdi
+	call	count
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rdi
+	call	shrink
+	movq	%rax, -24(%rbp)
+	movq	$.LC3, %rdi
+	movq	-16(%rbp), %rsi
+	movq	-24(%rbp), %rdx
+	movl	$0, %eax
+	call	printf
+.POS21:
+	movq	-8(%rbp), %rax
+	addq	$1, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -8(%rbp)
+	jmp	.POS19
+.POS22:
+	leave	
+	ret	
+	.size	main, .-main
+
+# end of generated code
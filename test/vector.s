@@ -0,0 +1,237 @@
+# start of generated code
+	.data	
+	.section		.rodata	
+.LC0:
+	.string	"%lld %.17g %.17g %.17g\n"
+	.text	
+	.globl	sum
+	.type	sum, @function
+sum:
+	movq	%rdi, -8(%rsp)
+	movsd	%xmm0, -16(%rsp)
+.POS0:
+	movq	.FL9(%rip), %rax
+	movq	%rax, -24(%rsp)
+	movq	$0, -32(%rsp)
+.POS1:
+	movq	-32(%rsp), %rax
+	cmpq	-8(%rsp), %rax
+	jge	.POS4
+.POS2:
+	movq	-32(%rsp), %rax
+	imulq	-32(%rsp), %rax
+	movq	%rax, -40(%rsp)
+	movq	-40(%rsp), %rax
+	addq	$1, %rax
+	movq	%rax, -48(%rsp)
+	movq	-48(%rsp), %rax
+	cvtsi2sdq	%rax, %xmm5
+	movsd	%xmm5, -40(%rsp)
+	movsd	-16(%rsp), %xmm5
+	divsd	-40(%rsp), %xmm5
+	movsd	%xmm5, -48(%rsp)
+	movsd	-24(%rsp), %xmm5
+	addsd	-48(%rsp), %xmm5
+	movsd	%xmm5, -40(%rsp)
+	movq	-40(%rsp), %rax
+	movq	%rax, -24(%rsp)
+.POS3:
+	movq	-32(%rsp), %rax
+	addq	$1, %rax
+	movq	%rax, -40(%rsp)
+	movq	-40(%rsp), %rax
+	movq	%rax, -32(%rsp)
+	jmp	.POS1
+.POS4:
+	movq	-24(%rsp), %rax
+	ret	
+	.size	sum, .-sum
+	.globl	product
+	.type	product, @function
+product:
+	movq	%rdi, -8(%rsp)
+	movsd	%xmm0, -16(%rsp)
+.POS5:
+	movq	.FL10(%rip), %rax
+	movq	%rax, -24(%rsp)
+	movq	$1, -32(%rsp)
+.POS6:
+	movq	-32(%rsp), %rax
+	cmpq	-8(%rsp), %rax
+	jg	.POS9
+.POS7:
+	movq	-32(%rsp), %rax
+	cvtsi2sdq	%rax, %xmm5
+	movsd	%xmm5, -40(%rsp)
+	movsd	-16(%rsp), %xmm5
+	divsd	-40(%rsp), %xmm5
+	movsd	%xmm5, -48(%rsp)
+	movsd	.FL10(%rip), %xmm5
+	addsd	-48(%rsp), %xmm5
+	movsd	%xmm5, -40(%rsp)
+	movsd	-24(%rsp), %xmm5
+	mulsd	-40(%rsp), %xmm5
+	movsd	%xmm5, -48(%rsp)
+	movq	-48(%rsp), %rax
+	movq	%rax, -24(%rsp)
+.POS8:
+	movq	-32(%rsp), %rax
+	addq	$1, %rax
+	movq	%rax, -40(%rsp)
+	movq	-40(%rsp), %rax
+	movq	%rax, -32(%rsp)
+	jmp	.POS6
+.POS9:
+	movq	-24(%rsp), %rax
+	ret	
+	.size	product, .-product
+	.globl	poly
+	.type	poly, @function
+poly:
+	movq	%rdi, -8(%rsp)
+	movsd	%xmm0, -16(%rsp)
+.POS10:
+	movq	.FL9(%rip), %rax
+	movq	%rax, -24(%rsp)
+	movq	$0, -32(%rsp)
+.POS11:
+	movq	-32(%rsp), %rax
+	cmpq	-8(%rsp), %rax
+	jge	.POS14
+.POS12:
+	movq	-32(%rsp), %rax
+	cvtsi2sdq	%rax, %xmm5
+	movsd	%xmm5, -40(%rsp)
+	movsd	-16(%rsp), %xmm5
+	mulsd	-40(%rsp), %xmm5
+	movsd	%xmm5, -48(%rsp)
+	movsd	-48(%rsp), %xmm5
+	addsd	.FL11(%rip), %xmm5
+	movsd	%xmm5, -40(%rsp)
+	movq	-32(%rsp), %rax
+	cvtsi2sdq	%rax, %xmm5
+	movsd	%xmm5, -48(%rsp)
+	movsd	-40(%rsp), %xmm5
+	mulsd	-48(%rsp), %xmm5
+	movsd	%xmm5, -56(%rsp)
+	movsd	-56(%rsp), %xmm5
+	subsd	-16(%rsp), %xmm5
+	movsd	%xmm5, -40(%rsp)
+	movq	-32(%rsp), %rax
+	cvtsi2sdq	%rax, %xmm5
+	movsd	%xmm5, -48(%rsp)
+	movsd	-40(%rsp), %xmm5
+	mulsd	-48(%rsp), %xmm5
+	movsd	%xmm5, -56(%rsp)
+	movsd	-24(%rsp), %xmm5
+	addsd	-56(%rsp), %xmm5
+	movsd	%xmm5, -40(%rsp)
+	movq	-40(%rsp), %rax
+	movq	%rax, -24(%rsp)
+.POS13:
+	movq	-32(%rsp), %rax
+	addq	$1, %rax
+	movq	%rax, -40(%rsp)
+	movq	-40(%rsp), %rax
+	movq	%rax, -32(%rsp)
+	jmp	.POS11
+.POS14:
+	movq	-24(%rsp), %rax
+	ret	
+	.size	poly, .-poly
+	.globl	main
+	.type	main, @function
+main:
+	pushq	%rbp
+	movq	%rsp, %rbp
+	subq	$32, %rsp
+.POS15:
+	movq	$0, -8(%rbp)
+.POS16:
+	cmpq	$12, -8(%rbp)
+	jge	.POS19
+.POS17:
+	movq	-8(%rbp), %rdi
+	movsd	.FL12(%rip), %xmm0
+	call	sum
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rdi
+	movsd	.FL13(%rip), %xmm0
+	call	product
+	movq	%rax, -24(%rbp)
+	movq	-8(%rbp), %rdi
+	movsd	.FL14(%rip), %xmm0
+	call	poly
+	movq	%rax, -32(%rbp)
+	movq	$.LC0, %rdi
+	movq	-8(%rbp), %rsi
+	movsd	-16(%rbp), %xmm0
+	movsd	-24(%rbp), %xmm1
+	movsd	-32(%rbp), %xmm2
+	movl	$3, %eax
+	call	printf
+.POS18:
+	movq	-8(%rbp), %rax
+	addq	$1, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -8(%rbp)
+	jmp	.POS16
+.POS19:
+	movq	$1001, -8(%rbp)
+.POS20:
+	cmpq	$1005, -8(%rbp)
+	jge	.POS23
+.POS21:
+	movq	-8(%rbp), %rdi
+	movsd	.FL15(%rip), %xmm0
+	call	sum
+	movq	%rax, -16(%rbp)
+	movq	-8(%rbp), %rdi
+	movsd	.FL16(%rip), %xmm0
+	call	product
+	movq	%rax, -24(%rbp)
+	movq	-8(%rbp), %rdi
+	movsd	.FL17(%rip), %xmm0
+	call	poly
+	movq	%rax, -32(%rbp)
+	movq	$.LC0, %rdi
+	movq	-8(%rbp), %rsi
+	movsd	-16(%rbp), %xmm0
+	movsd	-24(%rbp), %xmm1
+	movsd	-32(%rbp), %xmm2
+	movl	$3, %eax
+	call	printf
+.POS22:
+	movq	-8(%rbp), %rax
+	addq	$1, %rax
+	movq	%rax, -16(%rbp)
+	movq	-16(%rbp), %rax
+	movq	%rax, -8(%rbp)
+	jmp	.POS20
+.POS23:
+	leave	
+	ret	
+	.size	main, .-main
+	.section		.rodata	
+	.align	8
+.FL9:
+	.quad	0x0000000000000000
+.FL10:
+	.quad	0x3ff0000000000000
+.FL11:
+	.quad	0x3fe0000000000000
+.FL12:
+	.quad	0x3ff8000000000000
+.FL13:
+	.quad	0x3fe8000000000000
+.FL14:
+	.quad	0x4000000000000000
+.FL15:
+	.quad	0x3fb999999999999a
+.FL16:
+	.quad	0x3f50624dd2f1a9fc
+.FL17:
+	.quad	0x3fd3333333333333
+
+# end of generated code
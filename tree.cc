@@ -47,3 +47,62 @@ tree_node *tree_node::set(tree_node *t) {
    line_number = t->line_number;
    return this;
 }
+
+///////////////////////////////////////////////////////////////////////////
+//
+// find_flat_list / add_flat_list
+//
+// the table of flattened lists, chained by bucket; entries and buckets
+// live in the compilation arena and the table doubles when it is full
+//
+///////////////////////////////////////////////////////////////////////////
+static flat_list **flat_buckets = NULL;
+static int flat_size = 0;      // number of buckets, a power of two
+static int flat_count = 0;     // number of entries
+
+static int flat_hash(const void *list)
+{
+    unsigned long key = (unsigned long) list;
+    return (int) ((key >> 4) ^ (key >> 16)) & (flat_size - 1);
+}
+
+flat_list *find_flat_list(const void *list)
+{
+    if (flat_size == 0)
+	return NULL;
+    for (flat_list *f = flat_buckets[flat_hash(list)]; f; f = f->next)
+	if (f->list == list)
+	    return f;
+    return NULL;
+}
+
+flat_list *add_flat_list(const void *list, void *elems, int len)
+{
+    if (flat_count >= flat_size) {
+	flat_list **old = flat_buckets;
+	int old_size = flat_size;
+	flat_size = old_size ? 2 * old_size : 64;
+	flat_buckets = (flat_list **) compile_arena.allocate(sizeof(flat_list *) * flat_size);
+	for (int i = 0; i < flat_size; i++)
+	    flat_buckets[i] = NULL;
+	for (int i = 0; i < old_size; i++) {
+	    flat_list *next;
+	    for (flat_list *f = old[i]; f; f = next) {
+		next = f->next;
+		int h = flat_hash(f->list);
+		f->next = flat_buckets[h];
+		flat_buckets[h] = f;
+	    }
+	}
+    }
+
+    flat_list *f = (flat_list *) compile_arena.allocate(sizeof(flat_list));
+    f->list = list;
+    f->elems = elems;
+    f->len = len;
+    int h = flat_hash(list);
+    f->next = flat_buckets[h];
+    flat_buckets[h] = f;
+    flat_count++;
+    return f;
+}
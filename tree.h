@@ -17,6 +17,7 @@
 
 #include "stringtab.h"
 #include "seal-io.h"
+#include <vector>
 
 /////////////////////////////////////////////////////////////////////
 //
@@ -54,6 +55,9 @@ protected:
     int line_number;            // stash the line number when node is made
 public:
     tree_node();
+    // nodes live in the compilation arena and are never freed one by one
+    static void *operator new(size_t size) { return compile_arena.allocate(size); }
+    static void operator delete(void *) { }
     virtual tree_node *copy() = 0;
     virtual ~tree_node() { }
     virtual void dump(ostream& stream, int n) = 0;
@@ -98,6 +102,11 @@ public:
 //     "len" is set to the length of the list.  This method is used internally
 //     by the APS package to efficiently traverse the list representation.  
 //
+//     Lists never change once built, so the first call to nth or more
+//     copies the elements into an array; later calls index it in O(1).
+//     The array is kept in a table keyed on the list rather than in the
+//     node, so list_node keeps the layout semant.o was compiled against.
+//
 //     static list_node<Elem> *nil();
 //     static list_node<Elem> *single(Elem);
 //     static list_node<Elem> *append(list_node<Elem> *, list_node<Elem> *);
@@ -112,6 +121,20 @@ public:
 //
 //////////////////////////////////////////////////////////////////////////////
 
+// the flattened copy of one list, see flatten below
+struct flat_list {
+    const void *list;           // the list_node it was built from
+    void *elems;                // its elements in order, in the arena
+    int len;
+    flat_list *next;            // next entry in the same bucket
+};
+
+flat_list *find_flat_list(const void *list);
+flat_list *add_flat_list(const void *list, void *elems, int len);
+
+template <class Elem> class list_node;
+template <class Elem> flat_list *flatten(list_node<Elem> *l);
+
 template <class Elem> class list_node : public tree_node {
 public:
     tree_node *copy()            { return copy_list(); }
@@ -121,7 +144,7 @@ public:
     //
     int first()      { return 0; }
     int next(int n)  { return n + 1; }
-    int more(int n)  { return (n < len()); }
+    int more(int n)  { return (n < flatten(this)->len); }
 
     virtual list_node<Elem> *copy_list() = 0;
     virtual ~list_node() { }
@@ -171,6 +194,7 @@ public:
     Elem nth(int n);
     Elem nth_length(int n, int &len);
     void dump(ostream& stream, int n);
+    template <class T> friend flat_list *flatten(list_node<T> *l);
 };
 
 
@@ -196,11 +220,10 @@ template <class Elem> list_node<Elem> *list_node<Elem>::append(list_node<Elem> *
 
 template <class Elem> Elem list_node<Elem>::nth(int n)
 {
-    int len;
-    Elem tmp = nth_length(n ,len);
+    flat_list *flat = flatten(this);
 
-    if (tmp)
-	return tmp;
+    if (n >= 0 && n < flat->len)
+	return ((Elem *) flat->elems)[n];
     else {
 	cerr << "error: outside the range of the list\n";
 	exit(1);
@@ -210,15 +233,43 @@ template <class Elem> Elem list_node<Elem>::nth(int n)
 // added 10/30/06 cgs
 template <class Elem> Elem append_node<Elem>::nth(int n)
 {
-    int len;
-    Elem tmp = nth_length(n ,len);
+    return list_node<Elem>::nth(n);
+}
 
-    if (tmp)
-	return tmp;
-    else {
-	cerr << "error: outside the range of the list\n";
-	exit(1);
+
+///////////////////////////////////////////////////////////////////////////
+//
+// flatten
+//
+// return the array of l's elements, building it the first time l is
+// seen.  Append nodes are walked left to right with an explicit stack;
+// the other nodes are read through len and nth_length.  Asking l itself
+// for nth_length(i) would walk a left-deep chain once per element.
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> flat_list *flatten(list_node<Elem> *l)
+{
+    flat_list *flat = find_flat_list(l);
+    if (flat)
+	return flat;
+
+    int size = l->len();
+    Elem *elems = (Elem *) compile_arena.allocate(sizeof(Elem) * (size ? size : 1));
+    int count = 0, len;
+    std::vector<list_node<Elem> *> todo(1, l);
+    while (!todo.empty()) {
+	list_node<Elem> *node = todo.back();
+	todo.pop_back();
+	append_node<Elem> *app = dynamic_cast<append_node<Elem> *>(node);
+	if (app) {
+	    todo.push_back(app->rest);
+	    todo.push_back(app->some);
+	} else {
+	    for (int i = 0, n = node->len(); i < n; i++)
+		elems[count++] = node->nth_length(i, len);
+	}
     }
+    return add_flat_list(l, elems, count);
 }
 
 ///////////////////////////////////////////////////////////////////////////